@@ -1,46 +1,401 @@
 import esphome.codegen as cg
 import esphome.config_validation as cv
-from esphome.const import CONF_ID, CONF_PIN, CONF_NUM_LEDS
-from esphome import pins
+import esphome.final_validate as fv
+from esphome.const import CONF_ID, CONF_NAME, CONF_PIN, CONF_NUM_LEDS, CONF_RESTORE_VALUE
+from esphome.core import CORE
+from esphome import automation, pins
 
 argb_strip_ns = cg.esphome_ns.namespace("argb_strip")
 ARGBStripComponent = argb_strip_ns.class_("ARGBStripComponent", cg.Component)
+EffectType = argb_strip_ns.enum("EffectType", is_class=True)
+EffectParams = argb_strip_ns.struct("EffectParams")
+OutputBackend = argb_strip_ns.enum("OutputBackend", is_class=True)
+FrameRestore = argb_strip_ns.enum("FrameRestore", is_class=True)
+KeyFeedbackMode = argb_strip_ns.enum("KeyFeedbackMode", is_class=True)
+KeyFeedbackConfig = argb_strip_ns.struct("KeyFeedbackConfig")
+SetEffectAction = argb_strip_ns.class_("SetEffectAction", automation.Action)
+ClearEffectAction = argb_strip_ns.class_("ClearEffectAction", automation.Action)
+SaveSceneAction = argb_strip_ns.class_("SaveSceneAction", automation.Action)
+RecallSceneAction = argb_strip_ns.class_("RecallSceneAction", automation.Action)
+SetGroupColorAction = argb_strip_ns.class_("SetGroupColorAction", automation.Action)
 
 CONF_GROUPS = "groups"
 CONF_LEDS = "leds"
 CONF_MAX_BRIGHTNESS = "max_brightness"
 CONF_RFID_RAINBOW_CYCLE_MS = "rfid_rainbow_cycle_ms"
+CONF_USE_DMA = "use_dma"
+CONF_BACKEND = "backend"
+CONF_RESTORE_FRAME = "restore_frame"
+CONF_KEY_FEEDBACK = "key_feedback"
+CONF_MODE = "mode"
+CONF_DURATION = "duration"
+CONF_EFFECT_BUDGET = "effect_budget"
+CONF_MAX_FPS = "max_fps"
+CONF_COMPACT = "compact"
+CONF_FRAME_CACHE = "frame_cache"
+CONF_PIXEL_FORMAT = "pixel_format"
+CONF_CHIPSET = "chipset"
+CONF_SCENES = "scenes"
+CONF_SEGMENTS = "segments"
+CONF_SCENE = "scene"
+CONF_TRANSITION_LENGTH = "transition_length"
+CONF_GROUP = "group"
+CONF_ARGB_STRIP_ID = "argb_strip_id"
+CONF_EFFECT = "effect"
+CONF_COLOR = "color"
+CONF_PERIOD = "period"
+CONF_SIZE = "size"
+CONF_REVERSE = "reverse"
 
-CONFIG_SCHEMA = cv.Schema(
-    {
-        cv.GenerateID(): cv.declare_id(ARGBStripComponent),
-        cv.Required(CONF_PIN): pins.internal_gpio_output_pin_schema,
-        cv.Required(CONF_NUM_LEDS): cv.positive_int,
-        cv.Optional(CONF_RFID_RAINBOW_CYCLE_MS, default=8000): cv.int_range(min=500, max=60000),
-        cv.Required(CONF_GROUPS): cv.Schema(
-            {
-                cv.string: cv.Schema(
+EFFECT_TYPES = {
+    "breathe": EffectType.BREATHE,
+    "chase": EffectType.CHASE,
+    "comet": EffectType.COMET,
+    "progress": EffectType.PROGRESS,
+}
+
+# Each selects compile-time layout / timing traits in pixel_format.h.
+PIXEL_FORMATS = ["GRB", "RGB", "GRBW", "RGBW"]
+CHIPSETS = ["WS2812", "SK6812", "WS2811"]
+# rmt: one RMT channel per output. spi: one SPI host per output, always DMA,
+# leaves the RMT channels free; use_dma applies to rmt only.
+BACKENDS = {
+    "rmt": OutputBackend.RMT,
+    "spi": OutputBackend.SPI,
+}
+# Shows the last base frame at boot (not the arm-select overlay). rtc survives
+# software resets and OTA; flash also covers power loss.
+FRAME_RESTORE = {
+    "none": FrameRestore.NONE,
+    "rtc": FrameRestore.RTC,
+    "flash": FrameRestore.FLASH,
+}
+RTC_FRAME_MAX_BYTES = 2048  # larger strips only get the flash copy
+
+# Keypress feedback driven directly by k1_uart (see arm_strip_id there).
+# duration is the animation length, or for digits the idle timeout.
+KEY_FEEDBACK_MODES = {
+    "flash": KeyFeedbackMode.FLASH,
+    "ripple": KeyFeedbackMode.RIPPLE,
+    "digits": KeyFeedbackMode.DIGITS,
+}
+KEY_FEEDBACK_DEFAULT_DURATION_MS = {"flash": 200, "ripple": 400, "digits": 10000}
+
+MAX_GROUPS = 254  # 0xFF is reserved for "no group"
+MAX_SCENES = 254
+MAX_LEDS = 65535  # LED indices are 16-bit across all outputs
+
+
+def _unique_scene_names(scenes):
+    names = [s[CONF_NAME] for s in scenes]
+    for name in names:
+        if names.count(name) > 1:
+            raise cv.Invalid(f"Scene '{name}' is defined more than once")
+    return scenes
+
+
+def _validate_key_feedback(config):
+    if CONF_KEY_FEEDBACK in config and config[CONF_KEY_FEEDBACK][CONF_GROUP] not in config[CONF_GROUPS]:
+        raise cv.Invalid(f"key_feedback group '{config[CONF_KEY_FEEDBACK][CONF_GROUP]}' is not defined")
+    return config
+
+
+def _validate_total_leds(config):
+    total = config[CONF_NUM_LEDS] + sum(s[CONF_NUM_LEDS] for s in config[CONF_SEGMENTS])
+    if total > MAX_LEDS:
+        raise cv.Invalid(f"num_leds across all outputs is {total}, the maximum is {MAX_LEDS}")
+    return config
+
+
+CONFIG_SCHEMA = cv.All(
+    cv.Schema(
+        {
+            cv.GenerateID(): cv.declare_id(ARGBStripComponent),
+            cv.Required(CONF_PIN): pins.internal_gpio_output_pin_schema,
+            cv.Required(CONF_NUM_LEDS): cv.positive_int,
+            # Extra strips on their own GPIOs, numbered on from the first strip's
+            # LEDs. All outputs are composited together and sent in parallel.
+            cv.Optional(CONF_SEGMENTS, default=[]): cv.ensure_list(
+                cv.Schema(
                     {
-                        cv.Required(CONF_LEDS): [cv.positive_int],
-                        cv.Optional(CONF_MAX_BRIGHTNESS, default=255): cv.int_range(min=0, max=255),
+                        cv.Required(CONF_PIN): pins.internal_gpio_output_pin_schema,
+                        cv.Required(CONF_NUM_LEDS): cv.positive_int,
                     }
                 )
-            }
-        ),
-    }
+            ),
+            cv.Optional(CONF_PIXEL_FORMAT, default="GRB"): cv.one_of(*PIXEL_FORMATS, upper=True),
+            cv.Optional(CONF_CHIPSET, default="WS2812"): cv.one_of(*CHIPSETS, upper=True),
+            cv.Optional(CONF_RFID_RAINBOW_CYCLE_MS, default=8000): cv.int_range(min=500, max=60000),
+            cv.Optional(CONF_BACKEND, default="rmt"): cv.enum(BACKENDS, lower=True),
+            cv.Optional(CONF_USE_DMA, default=False): cv.boolean,
+            cv.Optional(CONF_RESTORE_FRAME, default="rtc"): cv.enum(FRAME_RESTORE, lower=True),
+            cv.Optional(CONF_EFFECT_BUDGET, default="2ms"): cv.positive_time_period_microseconds,
+            cv.Optional(CONF_MAX_FPS, default=25): cv.int_range(min=1, max=100),
+            cv.Optional(CONF_COMPACT, default=False): cv.boolean,
+            cv.Optional(CONF_FRAME_CACHE, default=False): cv.boolean,
+            cv.Required(CONF_GROUPS): cv.All(
+                cv.Schema(
+                    {
+                        cv.string: cv.Schema(
+                            {
+                                cv.Required(CONF_LEDS): [cv.int_range(min=0, max=65534)],
+                                cv.Optional(CONF_MAX_BRIGHTNESS, default=255): cv.int_range(min=0, max=255),
+                            }
+                        )
+                    }
+                ),
+                cv.Length(max=MAX_GROUPS),
+            ),
+            cv.Optional(CONF_KEY_FEEDBACK): cv.Schema(
+                {
+                    cv.Required(CONF_GROUP): cv.string,
+                    cv.Optional(CONF_MODE, default="flash"): cv.one_of(*KEY_FEEDBACK_MODES, lower=True),
+                    cv.Optional(CONF_COLOR, default=[255, 255, 255]): cv.All(
+                        [cv.int_range(min=0, max=255)], cv.Length(min=3, max=3)
+                    ),
+                    cv.Optional(CONF_DURATION): cv.positive_time_period_milliseconds,
+                }
+            ),
+            cv.Optional(CONF_SCENES, default=[]): cv.All(
+                cv.ensure_list(
+                    cv.Schema(
+                        {
+                            cv.Required(CONF_NAME): cv.valid_name,
+                            cv.Optional(CONF_RESTORE_VALUE, default=False): cv.boolean,
+                        }
+                    )
+                ),
+                cv.Length(max=MAX_SCENES),
+                _unique_scene_names,
+            ),
+        }
+    ),
+    _validate_total_leds,
+    _validate_key_feedback,
 )
 
+def group_index(strip_config, name):
+    """Dense integer id for a group, in declaration order. Used by platforms
+    so that runtime updates never look groups up by name."""
+    names = list(strip_config[CONF_GROUPS])
+    if name not in names:
+        raise cv.Invalid(f"Group '{name}' is not defined on argb_strip '{strip_config[CONF_ID].id}'")
+    return names.index(name)
+
+
+def scene_index(strip_config, name):
+    names = [s[CONF_NAME] for s in strip_config[CONF_SCENES]]
+    if name not in names:
+        raise cv.Invalid(f"Scene '{name}' is not defined on argb_strip '{strip_config[CONF_ID].id}'")
+    return names.index(name)
+
+
+def has_white_channel(strip_config):
+    return strip_config[CONF_PIXEL_FORMAT].endswith("W")
+
+
+def find_strip_config(strip_id):
+    conf = CORE.config.get("argb_strip")
+    confs = conf if isinstance(conf, list) else [conf]
+    for c in confs:
+        if c is not None and c[CONF_ID].id == strip_id.id:
+            return c
+    raise cv.Invalid(f"argb_strip '{strip_id.id}' not found")
+
+
+def validate_group_reference(config):
+    """FINAL_VALIDATE_SCHEMA for platforms that reference a strip group."""
+    full_config = fv.full_config.get()
+    path = full_config.get_path_for_id(config[CONF_ARGB_STRIP_ID])[:-1]
+    strip_config = full_config.get_config_for_path(path)
+    if config[CONF_GROUP] not in strip_config[CONF_GROUPS]:
+        raise cv.Invalid(f"Group '{config[CONF_GROUP]}' is not defined on the argb_strip")
+    return config
+
+
+# Actions name groups and scenes; they are checked against the strip once
+# the whole config is known, so a typo is reported as a config error
+# rather than failing during code generation.
+GROUP_ACTIONS = ("argb_strip.set_effect", "argb_strip.clear_effect", "argb_strip.set_group_color")
+SCENE_ACTIONS = ("argb_strip.save_scene", "argb_strip.recall_scene")
+
+
+def _find_actions(node, path):
+    if isinstance(node, dict):
+        for key, value in node.items():
+            if key in GROUP_ACTIONS + SCENE_ACTIONS and isinstance(value, dict):
+                yield key, value, path + [key]
+            yield from _find_actions(value, path + [key])
+    elif isinstance(node, list):
+        for i, item in enumerate(node):
+            yield from _find_actions(item, path + [i])
+
+
+def _final_validate_actions(config):
+    full_config = fv.full_config.get()
+    strip = config[CONF_ID].id
+    scenes = [s[CONF_NAME] for s in config[CONF_SCENES]]
+    for action, conf, path in _find_actions(full_config, []):
+        if CONF_ID not in conf or conf[CONF_ID].id != strip:
+            continue
+        where = "->".join(str(p) for p in path)
+        if action in GROUP_ACTIONS and conf[CONF_GROUP] not in config[CONF_GROUPS]:
+            raise cv.Invalid(f"{where}: group '{conf[CONF_GROUP]}' is not defined on argb_strip '{strip}'")
+        if action in SCENE_ACTIONS and conf[CONF_SCENE] not in scenes:
+            raise cv.Invalid(f"{where}: scene '{conf[CONF_SCENE]}' is not defined on argb_strip '{strip}'")
+    return config
+
+
+FINAL_VALIDATE_SCHEMA = _final_validate_actions
+
+
 async def to_code(config):
+    cg.add_define(f"USE_ARGB_STRIP_PIXEL_{config[CONF_PIXEL_FORMAT]}")
+    cg.add_define(f"USE_ARGB_STRIP_CHIPSET_{config[CONF_CHIPSET]}")
     var = cg.new_Pvariable(config[CONF_ID])
     pin = await cg.gpio_pin_expression(config[CONF_PIN])
     cg.add(var.set_pin(pin))
     cg.add(var.set_raw_gpio(config[CONF_PIN]["number"]))
     cg.add(var.set_num_leds(config[CONF_NUM_LEDS]))
+    for seg in config[CONF_SEGMENTS]:
+        seg_pin = await cg.gpio_pin_expression(seg[CONF_PIN])
+        cg.add(var.add_segment(seg_pin, seg[CONF_PIN]["number"], seg[CONF_NUM_LEDS]))
     cg.add(var.set_rfid_rainbow_cycle_ms(config[CONF_RFID_RAINBOW_CYCLE_MS]))
+    cg.add(var.set_backend(config[CONF_BACKEND]))
+    cg.add(var.set_use_dma(config[CONF_USE_DMA]))
+    cg.add(var.set_restore_frame(config[CONF_RESTORE_FRAME]))
+    if config[CONF_RESTORE_FRAME] != "none":
+        total = config[CONF_NUM_LEDS] + sum(s[CONF_NUM_LEDS] for s in config[CONF_SEGMENTS])
+        frame_bytes = total * (4 if has_white_channel(config) else 3)
+        if frame_bytes <= RTC_FRAME_MAX_BYTES:
+            cg.add_define("ARGB_STRIP_RTC_FRAME_BYTES", frame_bytes)
+    cg.add(var.set_effect_budget_us(config[CONF_EFFECT_BUDGET]))
+    cg.add(var.set_max_fps(config[CONF_MAX_FPS]))
+    cg.add(var.set_compact(config[CONF_COMPACT]))
+    cg.add(var.set_frame_cache(config[CONF_FRAME_CACHE]))
 
     for name, gconf in config[CONF_GROUPS].items():
         leds = gconf[CONF_LEDS]
         cap = gconf[CONF_MAX_BRIGHTNESS]
-        cg.add(var.add_group(name, leds, cap))
+        cg.add(var.add_group(group_index(config, name), name, leds, cap))
+
+    if CONF_KEY_FEEDBACK in config:
+        fb = config[CONF_KEY_FEEDBACK]
+        r, g, b = fb[CONF_COLOR]
+        duration = fb.get(CONF_DURATION, KEY_FEEDBACK_DEFAULT_DURATION_MS[fb[CONF_MODE]])
+        cg.add(
+            var.set_key_feedback(
+                cg.StructInitializer(
+                    KeyFeedbackConfig,
+                    ("group", group_index(config, fb[CONF_GROUP])),
+                    ("mode", KEY_FEEDBACK_MODES[fb[CONF_MODE]]),
+                    ("r", r),
+                    ("g", g),
+                    ("b", b),
+                    ("duration_ms", duration),
+                )
+            )
+        )
+
+    for idx, sconf in enumerate(config[CONF_SCENES]):
+        cg.add(var.add_scene(idx, sconf[CONF_NAME], sconf[CONF_RESTORE_VALUE]))
 
     await cg.register_component(var, config)
+
+
+@automation.register_action(
+    "argb_strip.set_effect",
+    SetEffectAction,
+    cv.Schema(
+        {
+            cv.Required(CONF_ID): cv.use_id(ARGBStripComponent),
+            cv.Required(CONF_GROUP): cv.string,
+            cv.Required(CONF_EFFECT): cv.enum(EFFECT_TYPES, lower=True),
+            cv.Optional(CONF_COLOR, default=[255, 255, 255]): cv.All(
+                [cv.int_range(min=0, max=255)], cv.Length(min=3, max=3)
+            ),
+            cv.Optional(CONF_PERIOD, default="2s"): cv.positive_time_period_milliseconds,
+            cv.Optional(CONF_SIZE, default=3): cv.int_range(min=1, max=1000),
+            cv.Optional(CONF_REVERSE, default=False): cv.boolean,
+        }
+    ),
+)
+async def argb_strip_set_effect_to_code(config, action_id, template_arg, args):
+    parent = await cg.get_variable(config[CONF_ID])
+    gid = group_index(find_strip_config(config[CONF_ID]), config[CONF_GROUP])
+    r, g, b = config[CONF_COLOR]
+    params = cg.StructInitializer(
+        EffectParams,
+        ("r", r),
+        ("g", g),
+        ("b", b),
+        ("period_ms", config[CONF_PERIOD]),
+        ("size", config[CONF_SIZE]),
+        ("reverse", config[CONF_REVERSE]),
+    )
+    return cg.new_Pvariable(action_id, template_arg, parent, gid, config[CONF_EFFECT], params)
+
+
+@automation.register_action(
+    "argb_strip.clear_effect",
+    ClearEffectAction,
+    cv.Schema(
+        {
+            cv.Required(CONF_ID): cv.use_id(ARGBStripComponent),
+            cv.Required(CONF_GROUP): cv.string,
+        }
+    ),
+)
+async def argb_strip_clear_effect_to_code(config, action_id, template_arg, args):
+    parent = await cg.get_variable(config[CONF_ID])
+    gid = group_index(find_strip_config(config[CONF_ID]), config[CONF_GROUP])
+    return cg.new_Pvariable(action_id, template_arg, parent, gid)
+
+
+SCENE_ACTION_SCHEMA = cv.Schema(
+    {
+        cv.Required(CONF_ID): cv.use_id(ARGBStripComponent),
+        cv.Required(CONF_SCENE): cv.string,
+    }
+)
+
+
+@automation.register_action("argb_strip.save_scene", SaveSceneAction, SCENE_ACTION_SCHEMA)
+async def argb_strip_save_scene_to_code(config, action_id, template_arg, args):
+    parent = await cg.get_variable(config[CONF_ID])
+    sid = scene_index(find_strip_config(config[CONF_ID]), config[CONF_SCENE])
+    return cg.new_Pvariable(action_id, template_arg, parent, sid)
+
+
+@automation.register_action(
+    "argb_strip.recall_scene",
+    RecallSceneAction,
+    SCENE_ACTION_SCHEMA.extend(
+        {
+            cv.Optional(CONF_TRANSITION_LENGTH, default="0s"): cv.positive_time_period_milliseconds,
+        }
+    ),
+)
+async def argb_strip_recall_scene_to_code(config, action_id, template_arg, args):
+    parent = await cg.get_variable(config[CONF_ID])
+    sid = scene_index(find_strip_config(config[CONF_ID]), config[CONF_SCENE])
+    return cg.new_Pvariable(action_id, template_arg, parent, sid, config[CONF_TRANSITION_LENGTH])
+
+
+@automation.register_action(
+    "argb_strip.set_group_color",
+    SetGroupColorAction,
+    cv.Schema(
+        {
+            cv.Required(CONF_ID): cv.use_id(ARGBStripComponent),
+            cv.Required(CONF_GROUP): cv.string,
+            cv.Required(CONF_COLOR): cv.All([cv.int_range(min=0, max=255)], cv.Length(min=3, max=3)),
+            cv.Optional(CONF_TRANSITION_LENGTH, default="0s"): cv.positive_time_period_milliseconds,
+        }
+    ),
+)
+async def argb_strip_set_group_color_to_code(config, action_id, template_arg, args):
+    parent = await cg.get_variable(config[CONF_ID])
+    gid = group_index(find_strip_config(config[CONF_ID]), config[CONF_GROUP])
+    r, g, b = config[CONF_COLOR]
+    return cg.new_Pvariable(action_id, template_arg, parent, gid, r, g, b, config[CONF_TRANSITION_LENGTH])
@@ -1,10 +1,17 @@
 // NOTE: This file is the 16c base plus ACTION mode additions (version 16d)
 #include "argb_strip.h"
+#include "pixel_kernels.h"
+#include "hue_wheel.h"
 #include "esphome/core/log.h"
+#include "esphome/core/helpers.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "esp_heap_caps.h"
+#include "esp_attr.h"
 #include <algorithm>
 #include <cmath>
+#include <cstring>
+#include <map>
 
 #ifndef pdMS_TO_TICKS
 #define pdMS_TO_TICKS(ms) ((ms) / portTICK_PERIOD_MS)
@@ -18,25 +25,259 @@ namespace argb_strip {
 
 static const char *const TAG = "argb_strip";
 
-static const uint32_t T0H = 16;
-static const uint32_t T0L = 34;
-static const uint32_t T1H = 32;
-static const uint32_t T1L = 18;
+// All channel offsets and pixel sizes below come from Pixel / BPP, and bit
+// timings from Timing; both are fixed per build (pixel_format.h).
+static constexpr uint8_t FULL_CHANNEL_MASK = (1 << Pixel::CHANNELS) - 1;
+
+// Composite WS2812 encoder: bytes encoder for the pixel data, then a copy
+// encoder that appends the reset latch, all inside one transaction.
+struct WS2812Encoder {
+  rmt_encoder_t base;
+  rmt_encoder_handle_t bytes_encoder;
+  rmt_encoder_handle_t copy_encoder;
+  int state;
+  rmt_symbol_word_t reset_code;
+};
+
+static size_t ws2812_encode(rmt_encoder_t *encoder, rmt_channel_handle_t channel,
+                            const void *data, size_t data_size, rmt_encode_state_t *ret_state) {
+  auto *enc = __containerof(encoder, WS2812Encoder, base);
+  rmt_encode_state_t session_state = RMT_ENCODING_RESET;
+  int state = RMT_ENCODING_RESET;
+  size_t encoded = 0;
+  switch (enc->state) {
+    case 0:
+      encoded += enc->bytes_encoder->encode(enc->bytes_encoder, channel, data, data_size, &session_state);
+      if (session_state & RMT_ENCODING_COMPLETE) enc->state = 1;
+      if (session_state & RMT_ENCODING_MEM_FULL) {
+        state |= RMT_ENCODING_MEM_FULL;
+        break;
+      }
+      // fall through
+    case 1:
+      encoded += enc->copy_encoder->encode(enc->copy_encoder, channel, &enc->reset_code,
+                                           sizeof(enc->reset_code), &session_state);
+      if (session_state & RMT_ENCODING_COMPLETE) {
+        enc->state = RMT_ENCODING_RESET;
+        state |= RMT_ENCODING_COMPLETE;
+      }
+      if (session_state & RMT_ENCODING_MEM_FULL) state |= RMT_ENCODING_MEM_FULL;
+      break;
+  }
+  *ret_state = (rmt_encode_state_t) state;
+  return encoded;
+}
+
+static esp_err_t ws2812_encoder_reset(rmt_encoder_t *encoder) {
+  auto *enc = __containerof(encoder, WS2812Encoder, base);
+  rmt_encoder_reset(enc->bytes_encoder);
+  rmt_encoder_reset(enc->copy_encoder);
+  enc->state = RMT_ENCODING_RESET;
+  return ESP_OK;
+}
+
+static esp_err_t ws2812_encoder_del(rmt_encoder_t *encoder) {
+  auto *enc = __containerof(encoder, WS2812Encoder, base);
+  if (enc->bytes_encoder) rmt_del_encoder(enc->bytes_encoder);
+  if (enc->copy_encoder) rmt_del_encoder(enc->copy_encoder);
+  delete enc;
+  return ESP_OK;
+}
+
+static esp_err_t new_ws2812_encoder(rmt_encoder_handle_t *ret) {
+  auto *enc = new WS2812Encoder{};
+  enc->base.encode = ws2812_encode;
+  enc->base.reset = ws2812_encoder_reset;
+  enc->base.del = ws2812_encoder_del;
+
+  rmt_bytes_encoder_config_t bcfg{};
+  bcfg.bit0.level0 = 1; bcfg.bit0.duration0 = Timing::T0H;
+  bcfg.bit0.level1 = 0; bcfg.bit0.duration1 = Timing::T0L;
+  bcfg.bit1.level0 = 1; bcfg.bit1.duration0 = Timing::T1H;
+  bcfg.bit1.level1 = 0; bcfg.bit1.duration1 = Timing::T1L;
+  bcfg.flags.msb_first = 1;
+  rmt_copy_encoder_config_t cpy_cfg{};
+  if (rmt_new_bytes_encoder(&bcfg, &enc->bytes_encoder) != ESP_OK ||
+      rmt_new_copy_encoder(&cpy_cfg, &enc->copy_encoder) != ESP_OK) {
+    ws2812_encoder_del(&enc->base);
+    return ESP_FAIL;
+  }
+
+  enc->reset_code.level0 = 0;
+  enc->reset_code.duration0 = Timing::RESET_TICKS;
+  enc->reset_code.level1 = 0;
+  enc->reset_code.duration1 = 0;
+  *ret = &enc->base;
+  return ESP_OK;
+}
+
+// SPI encoding. Each pixel bit becomes four SPI bits clocked at four times
+// the chipset's bit rate, high for as many quarters as T0H / T1H round to.
+// A nibble maps to two SPI bytes through a 16-entry table, so one pixel
+// byte costs two lookups and four stores; the DMA does the rest.
+static constexpr uint32_t SPI_BITS_PER_BIT = 4;
+static constexpr uint32_t SPI_BYTES_PER_BYTE = SPI_BITS_PER_BIT;  // 8 pixel bits -> 32 SPI bits
+static constexpr uint32_t SPI_CLOCK_HZ = 40'000'000u * SPI_BITS_PER_BIT / (Timing::T0H + Timing::T0L);
+// Reset latch as trailing zero bytes, rounded up.
+static constexpr size_t SPI_RESET_BYTES =
+    ((size_t) Timing::RESET_TICKS * SPI_BITS_PER_BIT / (Timing::T0H + Timing::T0L) + 7) / 8;
+
+static constexpr uint8_t spi_bit_pattern(uint32_t high, uint32_t period) {
+  uint32_t n = (high * SPI_BITS_PER_BIT * 2 + period) / (period * 2);
+  if (n < 1) n = 1;
+  if (n > SPI_BITS_PER_BIT - 1) n = SPI_BITS_PER_BIT - 1;
+  return (uint8_t)(((1u << n) - 1) << (SPI_BITS_PER_BIT - n));
+}
+static constexpr uint8_t SPI_BIT0 = spi_bit_pattern(Timing::T0H, Timing::T0H + Timing::T0L);
+static constexpr uint8_t SPI_BIT1 = spi_bit_pattern(Timing::T1H, Timing::T1H + Timing::T1L);
+
+struct SpiNibbleLut {
+  uint16_t v[16];
+  constexpr SpiNibbleLut() : v() {
+    for (int n = 0; n < 16; n++) {
+      uint16_t w = 0;
+      for (int b = 3; b >= 0; b--) w = (uint16_t)((w << 4) | (((n >> b) & 1) ? SPI_BIT1 : SPI_BIT0));
+      v[n] = w;
+    }
+  }
+};
+static constexpr SpiNibbleLut SPI_NIBBLE_LUT{};
+
+static void spi_encode(const uint8_t *src, size_t len, uint8_t *dst) {
+  for (size_t i = 0; i < len; i++, dst += SPI_BYTES_PER_BYTE) {
+    uint16_t hi = SPI_NIBBLE_LUT.v[src[i] >> 4];
+    uint16_t lo = SPI_NIBBLE_LUT.v[src[i] & 0x0F];
+    dst[0] = (uint8_t)(hi >> 8);
+    dst[1] = (uint8_t) hi;
+    dst[2] = (uint8_t)(lo >> 8);
+    dst[3] = (uint8_t) lo;
+  }
+}
+
+static inline void hue_to_pixel(uint16_t hue, uint8_t *px) {
+  hue_to_grb(hue, px[Pixel::G_OFF], px[Pixel::R_OFF], px[Pixel::B_OFF]);
+  if (Pixel::HAS_WHITE) px[Pixel::W_OFF] = 0;
+}
+
+// FNV-1a over the whole frame; compact mode's stand-in for last_sent_grb_ and
+// the boot frame checksum.
+static uint32_t frame_hash(const uint8_t *data, size_t len) {
+  uint32_t h = 2166136261u;
+  for (size_t i = 0; i < len; i++) {
+    h ^= data[i];
+    h *= 16777619u;
+  }
+  return h;
+}
+
+// Blends n pixels from src onto dst; ALPHA mixes by a (Q16).
+static inline void blend_pixels(uint8_t *dst, const uint8_t *src, size_t n, bool alpha, uint32_t a) {
+  if (!alpha) {
+    memcpy(dst, src, n * BPP);
+    return;
+  }
+  kernels::blend(dst, src, n * BPP, a);
+}
 
 // Group management
-void ARGBStripComponent::add_group(const std::string &name, const std::vector<int> &leds, uint16_t cap) {
-  groups_[name] = leds;
-  group_caps_[name] = cap;
+void ARGBStripComponent::add_group(uint8_t id, const std::string &name, const std::vector<uint16_t> &leds, uint16_t cap) {
+  if (id == NO_GROUP) return;
+  if (id >= groups_.size()) groups_.resize(id + 1);
+  auto &grp = groups_[id];
+  grp.name = name;
+  grp.cap = cap;
+  grp.runs.clear();
+  grp.count = 0;
+  grp.lo = 0xFFFF;
+  grp.hi = 0;
+  // num_leds is set before groups are added; out-of-range LEDs are dropped.
+  for (uint16_t led : leds) {
+    if (led >= num_leds_) continue;
+    if (!grp.runs.empty() && grp.runs.back().start + grp.runs.back().len == led) {
+      grp.runs.back().len++;
+    } else {
+      grp.runs.push_back(LedRun{led, 1});
+    }
+    grp.count++;
+    if (led < grp.lo) grp.lo = led;
+    if (led + 1 > grp.hi) grp.hi = led + 1;
+  }
+  grp.runs.shrink_to_fit();
+  if (grp.hi == 0) grp.lo = 0;
+
+  if (name == "away") arm_group_ids_[ARM_SLOT_AWAY] = id;
+  else if (name == "home") arm_group_ids_[ARM_SLOT_HOME] = id;
+  else if (name == "disarm") arm_group_ids_[ARM_SLOT_DISARM] = id;
+  else if (name == "custom") arm_group_ids_[ARM_SLOT_CUSTOM] = id;
+  scaling_luts_dirty_ = true;
+}
+void ARGBStripComponent::set_group_cap(uint8_t id, uint16_t cap) {
+  if (id >= groups_.size() || groups_[id].cap == cap) return;
+  groups_[id].cap = cap;
+  scaling_luts_dirty_ = true;
+  mark_dirty_();
+}
+uint8_t ARGBStripComponent::find_group(const std::string &name) const {
+  for (size_t i = 0; i < groups_.size(); i++) {
+    if (groups_[i].name == name) return (uint8_t) i;
+  }
+  return NO_GROUP;
+}
+uint16_t ARGBStripComponent::group_size(uint8_t id) const {
+  if (id >= groups_.size()) return 0;
+  return groups_[id].count;
 }
 const std::vector<int> *ARGBStripComponent::get_group(const std::string &name) const {
-  auto it = groups_.find(name);
-  if (it == groups_.end()) return nullptr;
-  return &it->second;
+  uint8_t id = find_group(name);
+  if (id >= groups_.size()) return nullptr;
+  legacy_group_.clear();
+  legacy_group_.reserve(groups_[id].count);
+  for_each_led_(groups_[id], [&](uint16_t led) { legacy_group_.push_back(led); });
+  return &legacy_group_;
+}
+uint16_t ARGBStripComponent::get_group_cap(uint8_t id) const {
+  if (id >= groups_.size()) return 255;
+  return groups_[id].cap;
+}
+ARGBStripComponent::LedRange ARGBStripComponent::group_range_(uint8_t group) const {
+  LedRange r;
+  if (group >= groups_.size()) return r;
+  r.lo = groups_[group].lo;
+  r.hi = std::min(groups_[group].hi, num_leds_);
+  return r;
+}
+bool ARGBStripComponent::group_covers_(uint8_t group, const LedRange &r) const {
+  if (group >= groups_.size() || groups_[group].runs.size() != 1) return false;
+  const auto &run = groups_[group].runs[0];
+  return run.start <= r.lo && run.start + run.len >= r.hi;
+}
+
+// Layer masks: BASE and RFID span the strip, the others their groups' LEDs.
+bool ARGBStripComponent::layer_covers_(uint8_t layer, const LedRange &r) const {
+  switch (layer) {
+    case LAYER_STATUS:
+      return group_covers_(status_group_, r);
+    case LAYER_KEYPAD:
+      return false;
+    case LAYER_EFFECTS:
+      for (const auto &e : effects_) {
+        if (group_covers_(e.group, r)) return true;
+      }
+      return false;
+    default:
+      return true;
+  }
 }
-uint16_t ARGBStripComponent::get_group_cap(const std::string &name) const {
-  auto it = group_caps_.find(name);
-  if (it == group_caps_.end()) return 255;
-  return it->second;
+
+// Changes hidden under an opaque layer are dropped; whoever removes that
+// layer marks the LEDs it covered.
+void ARGBStripComponent::mark_layer_dirty_(uint8_t layer, const LedRange &r) {
+  if (r.empty()) return;
+  for (uint8_t l = layer + 1; l < LAYER_COUNT; l++) {
+    if (layers_[l].enabled && layers_[l].opaque() && layer_covers_(l, r)) return;
+  }
+  layers_[layer].dirty.add(r);
+  frame_dirty_ = true;
 }
 
 void ARGBStripComponent::set_scaling_mode(const std::string &m) {
@@ -45,6 +286,7 @@ void ARGBStripComponent::set_scaling_mode(const std::string &m) {
   if (mm == "clamp") scaling_mode_ = ScalingMode::CLAMP;
   else if (mm == "perceptual") scaling_mode_ = ScalingMode::PERCEPTUAL;
   else scaling_mode_ = ScalingMode::LINEAR;
+  scaling_luts_dirty_ = true;
 }
 
 // Lifecycle
@@ -57,30 +299,53 @@ void ARGBStripComponent::setup() {
     this->mark_failed();
     return;
   }
-  pin_->setup();
-  pin_->digital_write(false);
+  // Output 0 covers the LEDs ahead of the first segment.
+  outputs_.insert(outputs_.begin(), StripOutput{pin_, raw_gpio_, 0, outputs_.empty() ? num_leds_ : outputs_[0].start});
+  for (auto &out : outputs_) {
+    if (!out.pin || out.raw_gpio < 0) {
+      ESP_LOGE(TAG, "Invalid pin configuration");
+      this->mark_failed();
+      return;
+    }
+    out.pin->setup();
+    out.pin->digital_write(false);
+  }
 
-  base_raw_grb_.assign(num_leds_ * 3, 0);
-  working_grb_.assign(num_leds_ * 3, 0);
-  last_sent_grb_.assign(num_leds_ * 3, 255);
+  base_raw_grb_.assign(num_leds_ * BPP, 0);
+  working_grb_.assign(num_leds_ * BPP, 0);
+  for (size_t i = 0; i < scenes_.size(); i++) {
+    if (scenes_[i].restore) load_scene_((uint8_t) i);
+  }
+  if (!compact_) last_sent_grb_.assign(num_leds_ * BPP, 0);
+  last_sent_valid_ = false;
 
-  init_rmt_();
-  if (!rmt_ready_) {
-    ESP_LOGE(TAG, "RMT init failed");
+  if (backend_ == OutputBackend::SPI) {
+    init_spi_();
+  } else {
+    init_rmt_();
+  }
+  if (!output_ready_) {
+    ESP_LOGE(TAG, "%s init failed", backend_ == OutputBackend::SPI ? "SPI" : "RMT");
     this->mark_failed();
     return;
   }
 
-  reset_symbol_.level0 = 0;
-  reset_symbol_.duration0 = 2000;
-  reset_symbol_.level1 = 0;
-  reset_symbol_.duration1 = 0;
-
   rainbow_start_ms_ = millis();
   rfid_transition_ = RfidTransitionState::INACTIVE;
+  layers_[LAYER_BASE].enabled = true;
+  layers_[LAYER_KEYPAD].blend = BlendMode::ALPHA;
   build_gamma_lut_if_needed_();
   action_rainbow_start_ms_ = rainbow_start_ms_; // initialize
+  bool restored = restore_boot_frame_();
   mark_dirty_();
+  if (restored) {
+    // Show it now rather than on the first loop, ahead of network setup.
+    frame_dirty_ = false;
+    recomposite_();
+    send_frame_();
+    schedule_next_frame_(millis());
+  }
+  boot_frame_dirty_ = false;
 }
 
 void ARGBStripComponent::dump_config() {
@@ -88,26 +353,76 @@ void ARGBStripComponent::dump_config() {
   LOG_PIN("  Pin: ", pin_);
   ESP_LOGCONFIG(TAG, "  Raw GPIO: %d", raw_gpio_);
   ESP_LOGCONFIG(TAG, "  LEDs: %u", num_leds_);
+  if (outputs_.size() > 1) {
+    for (size_t i = 0; i < outputs_.size(); i++) {
+      const auto &out = outputs_[i];
+      ESP_LOGCONFIG(TAG, "  Output %u: GPIO%d, LEDs %u-%u%s", (unsigned) i, out.raw_gpio, out.start,
+                    out.start + out.count - 1, out.dma ? " (DMA)" : "");
+    }
+#if SOC_RMT_SUPPORT_TX_SYNCHRO
+    ESP_LOGCONFIG(TAG, "  Output start: %s", sync_manager_ ? "synchronised" : "back-to-back");
+#else
+    ESP_LOGCONFIG(TAG, "  Output start: back-to-back");
+#endif
+  }
+  ESP_LOGCONFIG(TAG, "  Pixel format: %s, chipset: %s", PIXEL_FORMAT_NAME, CHIPSET_NAME);
+  ESP_LOGCONFIG(TAG, "  Pixel kernels: %s", kernels::KERNEL_NAME);
+  if (backend_ == OutputBackend::SPI) {
+    ESP_LOGCONFIG(TAG, "  Output backend: SPI at %u Hz (DMA)", (unsigned) SPI_CLOCK_HZ);
+  } else {
+    ESP_LOGCONFIG(TAG, "  Output backend: RMT");
+    ESP_LOGCONFIG(TAG, "  RMT DMA: %s", dma_active_ ? "YES" : (use_dma_ ? "REQUESTED (unavailable)" : "NO"));
+  }
   ESP_LOGCONFIG(TAG, "  Scaling Mode: %d", (int)scaling_mode_);
   ESP_LOGCONFIG(TAG, "  Perceptual Gamma: %.3f", perceptual_gamma_);
   ESP_LOGCONFIG(TAG, "  Rainbow Cycle (ms): %u", rainbow_cycle_ms_);
   ESP_LOGCONFIG(TAG, "  ACTION Cycle (ms): %u", ACTION_RAINBOW_CYCLE_MS);
-  for (auto &kv : groups_) {
-    ESP_LOGCONFIG(TAG, "    Group %s size=%u cap=%u",
-                  kv.first.c_str(), (unsigned)kv.second.size(), (unsigned)get_group_cap(kv.first));
+  ESP_LOGCONFIG(TAG, "  Max frame rate: %u fps", (unsigned)(1000 / frame_interval_ms_));
+  ESP_LOGCONFIG(TAG, "  Frame cache: %s", frame_cache_enabled_ ? "YES" : "NO");
+  if (key_feedback_.mode != KeyFeedbackMode::NONE && key_feedback_.group < groups_.size()) {
+    static const char *const FEEDBACK_NAMES[] = {"none", "flash", "ripple", "digits"};
+    ESP_LOGCONFIG(TAG, "  Key feedback: %s on group %s, %u ms", FEEDBACK_NAMES[(int) key_feedback_.mode],
+                  groups_[key_feedback_.group].name.c_str(), (unsigned) key_feedback_.duration_ms);
+  }
+  static const char *const RESTORE_NAMES[] = {"NONE", "RTC", "RTC + flash"};
+  ESP_LOGCONFIG(TAG, "  Restore last frame: %s", RESTORE_NAMES[(int) restore_frame_]);
+  ESP_LOGCONFIG(TAG, "  Effect budget: %u us/frame (skipped renders: %u)",
+                (unsigned) effect_budget_us_, (unsigned) effect_skips_);
+  for (size_t i = 0; i < groups_.size(); i++) {
+    ESP_LOGCONFIG(TAG, "    Group #%u %s size=%u cap=%u", (unsigned) i,
+                  groups_[i].name.c_str(), (unsigned)groups_[i].count, (unsigned)groups_[i].cap);
   }
+  for (size_t i = 0; i < scenes_.size(); i++) {
+    ESP_LOGCONFIG(TAG, "    Scene #%u %s%s%s", (unsigned) i, scenes_[i].name.c_str(),
+                  scenes_[i].grb.empty() ? " (empty)" : "", scenes_[i].restore ? " [restore]" : "");
+  }
+  log_memory_report_();
 }
 
 void ARGBStripComponent::loop() {
   uint32_t now = millis();
-  bool anim_tick = (now - last_anim_eval_) >= ANIM_TICK_MS;
+  bool due = deadline_armed_ && (int32_t)(now - next_deadline_ms_) >= 0;
+  if (due) {
+    deadline_armed_ = false;
+    last_frame_ms_ = now;
+  }
+  if (boot_frame_dirty_) save_boot_frame_();
+  if (layers_[LAYER_KEYPAD].enabled) {
+    if (now - key_feedback_start_ms_ >= key_feedback_.duration_ms) {
+      layers_[LAYER_KEYPAD].enabled = false;
+      key_digits_ = 0;
+      mark_group_dirty_(LAYER_KEYPAD, key_feedback_.group);
+    } else if (due && keypad_animating_()) {
+      mark_group_dirty_(LAYER_KEYPAD, key_feedback_.group);
+    }
+  }
 
   if (rfid_visual_active_()) {
-    if (anim_tick) mark_dirty_();
+    if (due) mark_layer_dirty_(LAYER_RFID, LedRange{0, num_leds_});
     if (rfid_transition_ == RfidTransitionState::FADE_IN) {
       if (now - rfid_transition_start_ms_ >= RFID_FADE_MS) {
         rfid_transition_ = RfidTransitionState::ACTIVE;
-        mark_dirty_();
+        mark_layer_dirty_(LAYER_RFID, LedRange{0, num_leds_});
       }
     } else if (rfid_transition_ == RfidTransitionState::FADE_OUT) {
       if (now - rfid_transition_start_ms_ >= RFID_FADE_MS) {
@@ -115,8 +430,15 @@ void ARGBStripComponent::loop() {
       }
     }
   } else {
-    if (arm_select_mode_ != ArmSelectMode::NONE && anim_tick) {
-      mark_dirty_(); // ensures ACTION rainbow animates
+    if (arm_select_mode_ != ArmSelectMode::NONE && due) {
+      mark_group_dirty_(LAYER_STATUS, status_group_);  // flash phase edge or ACTION frame
+    }
+    if (due) mark_effects_dirty_();
+    // Finished fades are dropped after a last frame at their target.
+    for (auto it = fades_.begin(); it != fades_.end();) {
+      bool done = fade_q16_(*it, now) >= FADE_Q16_ONE;
+      if (done || due) mark_layer_dirty_(LAYER_BASE, fade_range_(*it));
+      it = done ? fades_.erase(it) : it + 1;
     }
     if (arm_select_disable_pending_) {
       uint32_t phase = (now % (FLASH_ON_MS + FLASH_OFF_MS));
@@ -127,73 +449,593 @@ void ARGBStripComponent::loop() {
     }
   }
 
-  if (anim_tick) last_anim_eval_ = now;
-
+  if (!frame_dirty_ && !due) return;
   if (frame_dirty_) {
+    // In compact mode RMT reads working_grb_ directly, so it must be idle
+    // before we compose into it; retry on the next loop if not.
+    if (compact_ && !wait_tx_idle_(20)) return;
+    frame_dirty_ = false;  // recomposite_() may re-arm it for budget-skipped effects
     recomposite_();
     send_frame_();
-    frame_dirty_ = false;
   }
+  schedule_next_frame_(now);
+}
+
+void ARGBStripComponent::schedule_next_frame_(uint32_t now) {
+  bool any = false;
+  uint32_t best = 0;
+  auto consider = [&](uint32_t at) {
+    uint32_t rel = at - now;
+    if (!any || rel < best) best = rel;
+    any = true;
+  };
+  uint32_t next_frame = last_frame_ms_ + frame_interval_ms_;
+  if ((int32_t)(next_frame - now) < 0) next_frame = now;
+
+  if (rfid_visual_active_()) {
+    consider(next_frame);
+  } else {
+    if (arm_select_mode_ == ArmSelectMode::ACTION) {
+      consider(next_frame);
+    } else if (arm_select_mode_ != ArmSelectMode::NONE || arm_select_disable_pending_) {
+      // Static flash only changes at its on/off edges.
+      uint32_t cycle = FLASH_ON_MS + FLASH_OFF_MS;
+      uint32_t phase = now % cycle;
+      consider(now + (phase < FLASH_ON_MS ? FLASH_ON_MS - phase : cycle - phase));
+    }
+    for (auto &e : effects_) {
+      if (!e.settled) {
+        consider(next_frame);
+        break;
+      }
+    }
+    if (!fades_.empty()) consider(next_frame);
+    if (keypad_animating_()) consider(next_frame);
+  }
+
+  deadline_armed_ = any;
+  next_deadline_ms_ = now + best;
 }
 
 // RMT init
+void ARGBStripComponent::add_segment(GPIOPin *pin, int raw_gpio, uint16_t num_leds) {
+  if (num_leds == 0) return;
+  outputs_.push_back(StripOutput{pin, raw_gpio, num_leds_, num_leds});
+  num_leds_ += num_leds;
+}
+
 void ARGBStripComponent::init_rmt_() {
   rmt_tx_channel_config_t ch_cfg{};
-  ch_cfg.gpio_num = (gpio_num_t) raw_gpio_;
   ch_cfg.clk_src = RMT_CLK_SRC_DEFAULT;
   ch_cfg.resolution_hz = 40'000'000;
   ch_cfg.mem_block_symbols = 64;
   ch_cfg.trans_queue_depth = 4;
 
-  if (rmt_new_tx_channel(&ch_cfg, &tx_channel_) != ESP_OK) return;
+  // DMA-capable TX channels are scarce (one on the S3); once one request
+  // fails the remaining outputs go straight to plain channels.
+#if SOC_RMT_SUPPORT_DMA
+  bool try_dma = use_dma_;
+#else
+  if (use_dma_) ESP_LOGW(TAG, "RMT DMA not supported on this chip, ignoring use_dma");
+#endif
+  std::vector<rmt_channel_handle_t> channels;
+  for (auto &out : outputs_) {
+    ch_cfg.gpio_num = (gpio_num_t) out.raw_gpio;
+#if SOC_RMT_SUPPORT_DMA
+    if (try_dma) {
+      rmt_tx_channel_config_t dma_cfg = ch_cfg;
+      dma_cfg.mem_block_symbols = 1024;
+      dma_cfg.flags.with_dma = 1;
+      if (rmt_new_tx_channel(&dma_cfg, &out.channel) == ESP_OK) {
+        out.dma = dma_active_ = true;
+      } else {
+        ESP_LOGW(TAG, "RMT DMA channel unavailable for GPIO%d, falling back to non-DMA", out.raw_gpio);
+        out.channel = nullptr;
+        try_dma = false;
+      }
+    }
+#endif
+    if (!out.channel && rmt_new_tx_channel(&ch_cfg, &out.channel) != ESP_OK) {
+      ESP_LOGE(TAG, "No free RMT TX channel for GPIO%d", out.raw_gpio);
+      return;
+    }
+    if (new_ws2812_encoder(&out.encoder) != ESP_OK) return;
+    channels.push_back(out.channel);
+  }
 
-  rmt_bytes_encoder_config_t bcfg{};
-  bcfg.bit0.level0 = 1; bcfg.bit0.duration0 = T0H;
-  bcfg.bit0.level1 = 0; bcfg.bit0.duration1 = T0L;
-  bcfg.bit1.level0 = 1; bcfg.bit1.duration0 = T1H;
-  bcfg.bit1.level1 = 0; bcfg.bit1.duration1 = T1L;
-  bcfg.flags.msb_first = 1;
-  if (rmt_new_bytes_encoder(&bcfg, &bytes_encoder_) != ESP_OK) return;
+#if SOC_RMT_SUPPORT_TX_SYNCHRO
+  // Channels must be in the sync group before they are enabled.
+  if (channels.size() > 1) {
+    rmt_sync_manager_config_t sync_cfg{};
+    sync_cfg.tx_channel_array = channels.data();
+    sync_cfg.array_size = channels.size();
+    if (rmt_new_sync_manager(&sync_cfg, &sync_manager_) != ESP_OK) {
+      ESP_LOGW(TAG, "RMT sync manager unavailable, outputs start back-to-back");
+      sync_manager_ = nullptr;
+    }
+  }
+#endif
+  for (auto ch : channels) {
+    if (rmt_enable(ch) != ESP_OK) return;
+  }
 
-  rmt_copy_encoder_config_t cpy_cfg{};
-  if (rmt_new_copy_encoder(&cpy_cfg, &copy_encoder_) != ESP_OK) return;
+  tx_cfg_.loop_count = 0;
+  tx_cfg_.flags.eot_level = 0;
+  output_ready_ = true;
+}
 
-  if (rmt_enable(tx_channel_) != ESP_OK) return;
+// SPI init. One SPI host per output, MOSI only; the reset latch is the
+// zeroed tail of each DMA buffer and is never overwritten.
+void ARGBStripComponent::init_spi_() {
+  static const spi_host_device_t HOSTS[] = {
+      SPI2_HOST,
+#if SOC_SPI_PERIPH_NUM > 2
+      SPI3_HOST,
+#endif
+  };
+  static constexpr size_t NUM_HOSTS = sizeof(HOSTS) / sizeof(HOSTS[0]);
+  if (outputs_.size() > NUM_HOSTS) {
+    ESP_LOGE(TAG, "SPI backend supports %u outputs on this chip, %u configured", (unsigned) NUM_HOSTS,
+             (unsigned) outputs_.size());
+    return;
+  }
+  for (size_t i = 0; i < outputs_.size(); i++) {
+    auto &out = outputs_[i];
+    out.spi_len = (size_t) out.count * BPP * SPI_BYTES_PER_BYTE + SPI_RESET_BYTES;
+    out.spi_buf = (uint8_t *) heap_caps_calloc(1, out.spi_len, MALLOC_CAP_DMA);
+    if (!out.spi_buf) {
+      ESP_LOGE(TAG, "SPI DMA buffer allocation failed (%u B)", (unsigned) out.spi_len);
+      return;
+    }
+    spi_bus_config_t bus_cfg{};
+    bus_cfg.mosi_io_num = out.raw_gpio;
+    bus_cfg.miso_io_num = -1;
+    bus_cfg.sclk_io_num = -1;
+    bus_cfg.quadwp_io_num = -1;
+    bus_cfg.quadhd_io_num = -1;
+    bus_cfg.max_transfer_sz = (int) out.spi_len;
+    if (spi_bus_initialize(HOSTS[i], &bus_cfg, SPI_DMA_CH_AUTO) != ESP_OK) {
+      ESP_LOGE(TAG, "SPI host %d unavailable for GPIO%d (already in use?)", (int) HOSTS[i], out.raw_gpio);
+      return;
+    }
+    spi_device_interface_config_t dev_cfg{};
+    dev_cfg.clock_speed_hz = (int) SPI_CLOCK_HZ;
+    dev_cfg.mode = 0;
+    dev_cfg.spics_io_num = -1;
+    dev_cfg.queue_size = 1;
+    if (spi_bus_add_device(HOSTS[i], &dev_cfg, &out.spi) != ESP_OK) return;
+    out.spi_trans.length = out.spi_len * 8;
+    out.spi_trans.tx_buffer = out.spi_buf;
+  }
+  output_ready_ = true;
+}
 
-  tx_cfg_.loop_count = 0;
-  rmt_ready_ = true;
+// Queues one frame on every output. The transfers are non-blocking, so the
+// outputs run concurrently; with a sync manager they also share a start edge.
+bool ARGBStripComponent::transmit_outputs_(const uint8_t *frame) {
+  if (backend_ == OutputBackend::SPI) {
+    // The caller has waited for the previous frame, so the buffers are free.
+    // A failed queue leaves earlier outputs busy; wait_tx_idle_ collects them.
+    for (auto &out : outputs_) {
+      spi_encode(frame + out.start * BPP, (size_t) out.count * BPP, out.spi_buf);
+      if (spi_device_queue_trans(out.spi, &out.spi_trans, 0) != ESP_OK) break;
+      out.spi_busy = true;
+      tx_in_flight_ = true;
+    }
+    for (const auto &out : outputs_) {
+      if (!out.spi_busy) return false;
+    }
+    return true;
+  }
+  for (size_t i = 0; i < outputs_.size(); i++) {
+    const auto &out = outputs_[i];
+    if (rmt_transmit(out.channel, out.encoder, frame + out.start * BPP, (size_t) out.count * BPP, &tx_cfg_) ==
+        ESP_OK)
+      continue;
+    // Drop what was already queued so no channel is left waiting for the
+    // sync group to fill.
+    for (size_t j = 0; j < i; j++) {
+      rmt_disable(outputs_[j].channel);
+      rmt_enable(outputs_[j].channel);
+    }
+#if SOC_RMT_SUPPORT_TX_SYNCHRO
+    if (sync_manager_) rmt_sync_reset(sync_manager_);
+#endif
+    return false;
+  }
+  tx_in_flight_ = true;
+  return true;
+}
+
+bool ARGBStripComponent::wait_tx_idle_(uint32_t timeout_ms) {
+  if (!tx_in_flight_) return true;
+  for (auto &out : outputs_) {
+    if (backend_ == OutputBackend::SPI) {
+      spi_transaction_t *done;
+      if (out.spi_busy && spi_device_get_trans_result(out.spi, &done, pdMS_TO_TICKS(timeout_ms)) != ESP_OK) return false;
+      out.spi_busy = false;
+    } else if (rmt_tx_wait_all_done(out.channel, pdMS_TO_TICKS(timeout_ms)) != ESP_OK) {
+      return false;
+    }
+  }
+  tx_in_flight_ = false;
+  return true;
 }
 
 // Writes
-void ARGBStripComponent::update_group_channel(const std::string &group, uint8_t channel, uint8_t value) {
-  std::string target_group = get_arm_select_group_name_();
-  bool defer = (arm_select_mode_ != ArmSelectMode::NONE) &&
-               (!target_group.empty()) &&
-               (group == target_group) &&
-               !arm_select_disable_pending_;
-
-  if (defer) {
-    auto &pend = pending_writes_[group];
-    pend.used = true;
-    if (channel <= 2) {
-      pend.channel_set[channel] = true;
-      pend.values[channel] = value;
+void ARGBStripComponent::update_group_channel(uint8_t group, uint8_t channel, uint8_t value) {
+  if (channel >= Pixel::CHANNELS) return;
+  uint8_t rgbw[4] = {0, 0, 0, 0};
+  rgbw[channel] = value;
+  write_group_base_(group, 1 << channel, rgbw);
+}
+
+void ARGBStripComponent::set_group_rgbw(uint8_t group, uint8_t r, uint8_t g, uint8_t b, uint8_t w) {
+  const uint8_t rgbw[4] = {r, g, b, w};
+  write_group_base_(group, FULL_CHANNEL_MASK, rgbw);
+}
+
+// An immediate write ends the group's own fade and jumps its LEDs inside any
+// other fade, so it shows on the next frame.
+void ARGBStripComponent::write_group_base_(uint8_t group, uint8_t channel_mask, const uint8_t *rgb) {
+  if (group >= groups_.size()) return;
+  if (write_group_pixels_(base_raw_grb_.data(), group, channel_mask, rgb)) boot_frame_dirty_ = true;
+  if (!fades_.empty()) {
+    fades_.erase(std::remove_if(fades_.begin(), fades_.end(), [group](const BaseFade &f) { return f.group == group; }),
+                 fades_.end());
+    write_group_pixels_(fade_from_.data(), group, channel_mask, rgb);
+  }
+  mark_group_dirty_(LAYER_BASE, group);
+}
+
+// channel_mask bit n selects rgbw[n] (0=r, 1=g, 2=b, 3=w). Returns whether
+// any byte changed.
+bool ARGBStripComponent::write_group_pixels_(uint8_t *frame, uint8_t group, uint8_t channel_mask,
+                                             const uint8_t *rgbw) const {
+  bool changed = false;
+  if (channel_mask == FULL_CHANNEL_MASK) {
+    uint8_t want[BPP];
+    want[Pixel::R_OFF] = rgbw[0];
+    want[Pixel::G_OFF] = rgbw[1];
+    want[Pixel::B_OFF] = rgbw[2];
+    if (Pixel::HAS_WHITE) want[Pixel::W_OFF] = rgbw[3];
+    for_each_led_(groups_[group], [&](uint16_t led) {
+      uint8_t *px = &frame[led * BPP];
+      if (memcmp(px, want, BPP) == 0) return;
+      memcpy(px, want, BPP);
+      changed = true;
+    });
+  } else {
+    for (uint8_t c = 0; c < Pixel::CHANNELS; c++) {
+      if (!(channel_mask & (1 << c))) continue;
+      uint8_t off = Pixel::offset(c), value = rgbw[c];
+      for_each_led_(groups_[group], [&](uint16_t led) {
+        uint8_t &px = frame[led * BPP + off];
+        changed |= px != value;
+        px = value;
+      });
+    }
+  }
+  return changed;
+}
+
+// Transitions
+void ARGBStripComponent::transition_group_rgbw(uint8_t group, uint8_t r, uint8_t g, uint8_t b, uint8_t w,
+                                               uint32_t duration_ms) {
+  if (group >= groups_.size()) return;
+  if (duration_ms == 0) {
+    set_group_rgbw(group, r, g, b, w);
+    return;
+  }
+  const uint8_t rgbw[4] = {r, g, b, w};
+  start_fade_(group, duration_ms);
+  if (write_group_pixels_(base_raw_grb_.data(), group, FULL_CHANNEL_MASK, rgbw)) boot_frame_dirty_ = true;
+  mark_group_dirty_(LAYER_BASE, group);
+}
+
+void ARGBStripComponent::transition_frame(const uint8_t *grb, uint32_t duration_ms) {
+  if (duration_ms == 0) {
+    fades_.clear();
+  } else {
+    start_fade_(NO_GROUP, duration_ms);
+  }
+  if (memcmp(base_raw_grb_.data(), grb, base_raw_grb_.size()) != 0) {
+    memcpy(base_raw_grb_.data(), grb, base_raw_grb_.size());
+    boot_frame_dirty_ = true;
+  }
+  mark_dirty_();
+}
+
+// Call before base_raw_grb_ changes. A strip-wide fade replaces every fade;
+// a group fade replaces that group's previous one.
+void ARGBStripComponent::start_fade_(uint8_t group, uint32_t ms) {
+  uint32_t now = millis();
+  BaseFade fade{group, now, ms};
+  LedRange r = fade_range_(fade);
+  if (fade_from_.size() != base_raw_grb_.size()) fade_from_.assign(base_raw_grb_.begin(), base_raw_grb_.end());
+  if (!r.empty()) {
+    if (fade_shown_.size() != base_raw_grb_.size()) fade_shown_.resize(base_raw_grb_.size());
+    uint8_t *shown = fade_shown_.data();
+    compose_base_(shown, r, now);
+    if (group == NO_GROUP) {
+      memcpy(fade_from_.data() + r.lo * BPP, shown + r.lo * BPP, (r.hi - r.lo) * BPP);
+    } else {
+      for_each_led_(groups_[group], [&](uint16_t led) { memcpy(&fade_from_[led * BPP], &shown[led * BPP], BPP); });
+    }
+  }
+  if (group == NO_GROUP) {
+    fades_.clear();
+  } else {
+    fades_.erase(std::remove_if(fades_.begin(), fades_.end(), [group](const BaseFade &f) { return f.group == group; }),
+                 fades_.end());
+  }
+  fades_.push_back(fade);
+}
+
+uint32_t ARGBStripComponent::fade_q16_(const BaseFade &f, uint32_t now) const {
+  uint32_t elapsed = now - f.start_ms;
+  if (elapsed >= f.duration_ms) return FADE_Q16_ONE;
+  return (uint32_t)(((uint64_t) elapsed * FADE_Q16_ONE + f.duration_ms / 2) / f.duration_ms);
+}
+
+ARGBStripComponent::LedRange ARGBStripComponent::fade_range_(const BaseFade &f) const {
+  return f.group == NO_GROUP ? LedRange{0, num_leds_} : group_range_(f.group);
+}
+
+// Writes the base layer as currently shown for r into dst (strip-indexed).
+void ARGBStripComponent::compose_base_(uint8_t *dst, const LedRange &r, uint32_t now) const {
+  memcpy(dst + r.lo * BPP, base_raw_grb_.data() + r.lo * BPP, (r.hi - r.lo) * BPP);
+  for (const auto &f : fades_) {
+    uint32_t a = fade_q16_(f, now);
+    auto span = [&](uint16_t lo, uint16_t hi) {
+      memcpy(dst + lo * BPP, fade_from_.data() + lo * BPP, (hi - lo) * BPP);
+      blend_pixels(dst + lo * BPP, base_raw_grb_.data() + lo * BPP, hi - lo, true, a);
+    };
+    if (f.group == NO_GROUP) {
+      span(r.lo, r.hi);
+      continue;
+    }
+    for (const auto &run : groups_[f.group].runs) {
+      uint16_t lo = std::max(run.start, r.lo);
+      uint16_t hi = std::min<uint16_t>(run.start + run.len, r.hi);
+      if (lo < hi) span(lo, hi);
     }
+  }
+}
+
+// Scenes
+void ARGBStripComponent::add_scene(uint8_t id, const std::string &name, bool restore) {
+  if (id == NO_GROUP) return;
+  if (id >= scenes_.size()) scenes_.resize(id + 1);
+  scenes_[id].name = name;
+  scenes_[id].restore = restore;
+}
+
+uint8_t ARGBStripComponent::find_scene(const std::string &name) const {
+  for (size_t i = 0; i < scenes_.size(); i++) {
+    if (scenes_[i].name == name) return (uint8_t) i;
+  }
+  return NO_GROUP;
+}
+
+bool ARGBStripComponent::save_scene(uint8_t id) {
+  if (id >= scenes_.size()) return false;
+  scenes_[id].grb = base_raw_grb_;
+  if (scenes_[id].restore) store_scene_(id);
+  ESP_LOGD(TAG, "Scene %s saved", scenes_[id].name.c_str());
+  return true;
+}
+
+// The whole base frame changes in one memcpy, so the next loop composes and
+// transmits the new look as a single frame.
+bool ARGBStripComponent::recall_scene(uint8_t id, uint32_t transition_ms) {
+  if (id >= scenes_.size()) return false;
+  const auto &scene = scenes_[id];
+  if (scene.grb.size() != base_raw_grb_.size()) {
+    ESP_LOGW(TAG, "Scene %s has not been saved", scene.name.c_str());
+    return false;
+  }
+  transition_frame(scene.grb.data(), transition_ms);
+  ESP_LOGD(TAG, "Scene %s recalled (%u ms)", scene.name.c_str(), (unsigned) transition_ms);
+  return true;
+}
+
+uint32_t ARGBStripComponent::scene_pref_key_(uint8_t id) const {
+  return fnv1_hash("argb_strip_scene_" + scenes_[id].name) + (uint32_t) raw_gpio_ * 0x100;
+}
+
+void ARGBStripComponent::store_scene_(uint8_t id) {
+  if (!store_frame_(scene_pref_key_(id), scenes_[id].grb)) {
+    ESP_LOGW(TAG, "Failed to persist scene %s", scenes_[id].name.c_str());
+  }
+}
+
+void ARGBStripComponent::load_scene_(uint8_t id) {
+  if (load_frame_(scene_pref_key_(id), scenes_[id].grb)) ESP_LOGD(TAG, "Scene %s restored", scenes_[id].name.c_str());
+}
+
+bool ARGBStripComponent::store_frame_(uint32_t key, const std::vector<uint8_t> &grb) {
+  SceneHeader hdr{num_leds_, BPP};
+  SceneChunk chunk{};
+  for (uint16_t k = 0, led = 0; led < num_leds_; k++, led += SCENE_CHUNK_LEDS) {
+    uint16_t n = std::min<uint16_t>(SCENE_CHUNK_LEDS, num_leds_ - led);
+    memcpy(chunk.grb, &grb[led * BPP], n * BPP);
+    auto pref = global_preferences->make_preference<SceneChunk>(key + 1 + k);
+    if (!pref.save(&chunk)) return false;
+  }
+  // Header last, so a partially written frame is never loaded.
+  auto pref = global_preferences->make_preference<SceneHeader>(key);
+  return pref.save(&hdr);
+}
+
+bool ARGBStripComponent::load_frame_(uint32_t key, std::vector<uint8_t> &out) {
+  SceneHeader hdr{};
+  auto pref = global_preferences->make_preference<SceneHeader>(key);
+  if (!pref.load(&hdr) || hdr.num_leds != num_leds_ || hdr.bytes_per_pixel != BPP) return false;
+  std::vector<uint8_t> grb(num_leds_ * BPP);
+  SceneChunk chunk;
+  for (uint16_t k = 0, led = 0; led < num_leds_; k++, led += SCENE_CHUNK_LEDS) {
+    auto cp = global_preferences->make_preference<SceneChunk>(key + 1 + k);
+    if (!cp.load(&chunk)) return false;
+    uint16_t n = std::min<uint16_t>(SCENE_CHUNK_LEDS, num_leds_ - led);
+    memcpy(&grb[led * BPP], chunk.grb, n * BPP);
+  }
+  out.swap(grb);
+  return true;
+}
+
+// Boot frame. The RTC copy is rewritten whenever a write changes the base
+// targets and checked against a magic and checksum, so whatever a cold boot
+// leaves in RTC memory is ignored. Live writes after boot simply overwrite
+// the restored groups; nothing has to be cleared.
+static constexpr uint32_t BOOT_FLASH_DELAY_MS = 5000;
+
+// __init__.py sizes the RTC block to the strip (at most 2 KB) and leaves it
+// out entirely with restore_frame: none.
+#ifdef ARGB_STRIP_RTC_FRAME_BYTES
+static constexpr uint32_t RTC_BOOT_MAGIC = 0x41524742;  // "ARGB"
+static constexpr size_t RTC_BOOT_MAX_BYTES = ARGB_STRIP_RTC_FRAME_BYTES;
+
+struct RtcBootFrame {
+  uint32_t magic;
+  uint32_t checksum;  // num_leds through the end of the frame
+  uint16_t num_leds;
+  uint8_t bytes_per_pixel;
+  uint8_t reserved;
+  uint8_t grb[RTC_BOOT_MAX_BYTES];
+};
+static RTC_NOINIT_ATTR RtcBootFrame rtc_boot_frame;
+
+static uint32_t rtc_boot_checksum(const RtcBootFrame &f, size_t bytes) {
+  return frame_hash((const uint8_t *) &f.num_leds, offsetof(RtcBootFrame, grb) - offsetof(RtcBootFrame, num_leds) + bytes);
+}
+#endif
+
+static uint32_t boot_pref_key(int raw_gpio, const char *what) {
+  return fnv1_hash(std::string("argb_strip_boot_") + what) + (uint32_t) raw_gpio * 0x100;
+}
+
+bool ARGBStripComponent::restore_boot_frame_() {
+  if (restore_frame_ == FrameRestore::NONE) return false;
+  const char *source = nullptr;
+#ifdef ARGB_STRIP_RTC_FRAME_BYTES
+  size_t bytes = base_raw_grb_.size();
+  const auto &rtc = rtc_boot_frame;
+  if (rtc.magic == RTC_BOOT_MAGIC && rtc.num_leds == num_leds_ && rtc.bytes_per_pixel == BPP &&
+      bytes <= RTC_BOOT_MAX_BYTES && rtc.checksum == rtc_boot_checksum(rtc, bytes)) {
+    memcpy(base_raw_grb_.data(), rtc.grb, bytes);
+    source = "RTC memory";
+  }
+#endif
+  if (source == nullptr) {
+    if (restore_frame_ != FrameRestore::FLASH || !load_frame_(boot_pref_key(raw_gpio_, "frame"), base_raw_grb_))
+      return false;
+    source = "flash";
+  }
+  // The arm-select overlay is not replayed: the keypad only sends A3 when
+  // the mode changes, so a restored one could flash until the next change.
+  ESP_LOGI(TAG, "Boot frame restored from %s", source);
+  return true;
+}
+
+void ARGBStripComponent::save_boot_frame_() {
+  boot_frame_dirty_ = false;
+  if (restore_frame_ == FrameRestore::NONE) return;
+#ifdef ARGB_STRIP_RTC_FRAME_BYTES
+  size_t bytes = base_raw_grb_.size();
+  if (bytes <= RTC_BOOT_MAX_BYTES) {
+    auto &rtc = rtc_boot_frame;
+    rtc.magic = 0;  // invalid while it is being rewritten
+    rtc.num_leds = num_leds_;
+    rtc.bytes_per_pixel = BPP;
+    rtc.reserved = 0;
+    memcpy(rtc.grb, base_raw_grb_.data(), bytes);
+    rtc.checksum = rtc_boot_checksum(rtc, bytes);
+    rtc.magic = RTC_BOOT_MAGIC;
+  }
+#endif
+  // Re-armed on every change, so flash is written once things settle.
+  if (restore_frame_ == FrameRestore::FLASH) {
+    this->set_timeout("boot_frame", BOOT_FLASH_DELAY_MS, [this]() { store_boot_frame_flash_(); });
+  }
+}
+
+void ARGBStripComponent::store_boot_frame_flash_() {
+  if (!store_frame_(boot_pref_key(raw_gpio_, "frame"), base_raw_grb_)) {
+    ESP_LOGW(TAG, "Failed to persist boot frame");
+  }
+}
+
+// Effects
+void ARGBStripComponent::set_group_effect(uint8_t group, EffectType type, const EffectParams &params) {
+  if (group >= groups_.size()) return;
+  auto effect = make_effect(type, params);
+  if (!effect) return;
+  ActiveEffect *slot = nullptr;
+  for (auto &e : effects_) {
+    if (e.group == group) slot = &e;
+  }
+  if (!slot) {
+    effects_.push_back(ActiveEffect{});
+    slot = &effects_.back();
+  }
+  slot->group = group;
+  slot->effect = std::move(effect);
+  slot->start_ms = millis();
+  slot->pixels.assign(groups_[group].count * BPP, 0);
+  slot->rendered = false;
+  slot->settled = false;
+  layers_[LAYER_EFFECTS].enabled = true;
+  ESP_LOGD(TAG, "Group %s effect -> %s", groups_[group].name.c_str(), effect_type_name(type));
+  mark_group_dirty_(LAYER_EFFECTS, group);
+}
+
+void ARGBStripComponent::clear_group_effect(uint8_t group) {
+  for (auto it = effects_.begin(); it != effects_.end(); ++it) {
+    if (it->group != group) continue;
+    effects_.erase(it);
+    effect_rr_ = 0;
+    layers_[LAYER_EFFECTS].enabled = !effects_.empty();
+    mark_group_dirty_(LAYER_EFFECTS, group);
     return;
   }
+}
+
+void ARGBStripComponent::mark_effects_dirty_() {
+  for (auto &e : effects_) {
+    if (e.settled) continue;
+    e.rendered = false;
+    mark_group_dirty_(LAYER_EFFECTS, e.group);
+  }
+}
 
-  auto g = get_group(group);
-  if (!g) return;
-  for (int led : *g) {
-    if (led < 0 || (uint16_t)led >= num_leds_) continue;
-    uint32_t base = led * 3;
-    switch (channel) {
-      case 0: base_raw_grb_[base + 1] = value; break;
-      case 1: base_raw_grb_[base + 0] = value; break;
-      case 2: base_raw_grb_[base + 2] = value; break;
+// Renders stale effects round-robin until the budget is spent, then paints
+// the part of every effect inside the range from its cached pixels.
+void ARGBStripComponent::apply_effects_(const LedRange &r) {
+  if (effects_.empty()) return;
+  uint32_t now = millis();
+  uint32_t t0 = micros();
+  size_t n = effects_.size();
+  bool over_budget = false;
+  for (size_t k = 0; k < n; k++) {
+    size_t idx = (effect_rr_ + k) % n;
+    auto &e = effects_[idx];
+    if (e.rendered) continue;
+    if (over_budget || (micros() - t0) >= effect_budget_us_) {
+      if (!over_budget) effect_rr_ = idx;
+      over_budget = true;
+      effect_skips_++;
+      mark_group_dirty_(LAYER_EFFECTS, e.group);
+      continue;
     }
+    uint32_t t = now - e.start_ms;
+    e.effect->render(e.pixels.data(), (uint16_t)(e.pixels.size() / BPP), t);
+    e.rendered = true;
+    e.settled = e.effect->finished(t);
   }
-  if (!rfid_visual_active_()) mark_dirty_();
+  if (!over_budget) effect_rr_ = 0;
+
+  for (auto &e : effects_) blend_group_(e.group, e.pixels.data(), r, layers_[LAYER_EFFECTS]);
 }
 
 // Control
@@ -203,42 +1045,28 @@ void ARGBStripComponent::enable_rfid_mode() {
   rainbow_start_ms_ = millis();
   rfid_transition_ = RfidTransitionState::FADE_IN;
   rfid_transition_start_ms_ = rainbow_start_ms_;
-  mark_dirty_();
+  layers_[LAYER_RFID].enabled = true;
+  mark_layer_dirty_(LAYER_RFID, LedRange{0, num_leds_});
 }
 
 void ARGBStripComponent::disable_rfid_mode() {
   if (strip_mode_ != StripMode::RFID_PROGRAM || rfid_transition_ == RfidTransitionState::FADE_OUT) return;
   rfid_transition_ = RfidTransitionState::FADE_OUT;
   rfid_transition_start_ms_ = millis();
-  mark_dirty_();
+  mark_layer_dirty_(LAYER_RFID, LedRange{0, num_leds_});
 }
 
 void ARGBStripComponent::finish_rfid_fade_out_() {
   strip_mode_ = StripMode::NORMAL;
   rfid_transition_ = RfidTransitionState::INACTIVE;
-  if (arm_select_disable_pending_) {
-    finalize_arm_select_disable_();
-  } else {
-    mark_dirty_();
-  }
+  layers_[LAYER_RFID].enabled = false;
+  mark_dirty_();
+  if (arm_select_disable_pending_) finalize_arm_select_disable_();
 }
 
 void ARGBStripComponent::set_arm_select_mode(ArmSelectMode m) {
   if (arm_select_mode_ == m) return;
 
-  std::string prev_group = get_arm_select_group_name_();
-  std::string new_group;
-  switch (m) {
-    case ArmSelectMode::AWAY: new_group = "away"; break;
-    case ArmSelectMode::HOME: new_group = "home"; break;
-    case ArmSelectMode::DISARM: new_group = "disarm"; break;
-    case ArmSelectMode::NIGHT:
-    case ArmSelectMode::VACATION:
-    case ArmSelectMode::BYPASS:
-    case ArmSelectMode::ACTION: new_group = "custom"; break;
-    default: break;
-  }
-
   if (m == ArmSelectMode::NONE) {
     if (arm_select_mode_ != ArmSelectMode::NONE) {
       arm_select_disable_pending_ = true;
@@ -246,37 +1074,50 @@ void ARGBStripComponent::set_arm_select_mode(ArmSelectMode m) {
     return;
   }
 
-  if (arm_select_disable_pending_) {
-    arm_select_disable_pending_ = false;
-    if (!prev_group.empty()) apply_pending_for_group_(prev_group);
-  }
-
-  if (arm_select_mode_ != ArmSelectMode::NONE && !prev_group.empty() && prev_group != new_group) {
-    apply_pending_for_group_(prev_group);
+  // Re-snapshot the held colours whenever the overlay moves or restarts;
+  // switching between modes that share a group keeps the original hold.
+  uint8_t new_group = arm_select_group_id_(m);
+  if (new_group != status_group_ || arm_select_mode_ == ArmSelectMode::NONE || arm_select_disable_pending_) {
+    set_status_group_(new_group);
   }
+  arm_select_disable_pending_ = false;
 
   arm_select_mode_ = m;
   if (m == ArmSelectMode::ACTION) {
     action_rainbow_start_ms_ = millis();
   }
-
-  if (arm_select_mode_ != ArmSelectMode::NONE && !new_group.empty()) {
-    if (prev_group != new_group) {
-      auto &pend = pending_writes_[new_group];
-      pend.used = true;
-      pend.channel_set = {false,false,false};
-    }
-  }
-
-  if (!rfid_visual_active_()) mark_dirty_();
+  mark_group_dirty_(LAYER_STATUS, status_group_);
 }
 
 void ARGBStripComponent::finalize_arm_select_disable_() {
-  std::string prev_group = get_arm_select_group_name_();
-  if (!prev_group.empty()) apply_pending_for_group_(prev_group);
   arm_select_mode_ = ArmSelectMode::NONE;
   arm_select_disable_pending_ = false;
-  if (!rfid_visual_active_()) mark_dirty_();
+  set_status_group_(NO_GROUP);
+}
+
+// Holds the group at what the base layer shows right now, so a group in
+// the middle of a fade neither jumps to its target when the overlay starts
+// nor when it is removed.
+void ARGBStripComponent::set_status_group_(uint8_t group) {
+  LedRange old = group_range_(status_group_);
+  status_group_ = group < groups_.size() ? group : NO_GROUP;
+  status_pixels_.clear();
+  layers_[LAYER_STATUS].enabled = status_group_ != NO_GROUP;
+  if (status_group_ != NO_GROUP) {
+    const uint8_t *shown = base_raw_grb_.data();
+    if (!fades_.empty()) {
+      if (fade_shown_.size() != base_raw_grb_.size()) fade_shown_.resize(base_raw_grb_.size());
+      compose_base_(fade_shown_.data(), group_range_(status_group_), millis());
+      shown = fade_shown_.data();
+    }
+    status_pixels_.reserve(groups_[group].count * BPP);
+    for_each_led_(groups_[group], [&](uint16_t led) {
+      const uint8_t *px = &shown[led * BPP];
+      status_pixels_.insert(status_pixels_.end(), px, px + BPP);
+    });
+  }
+  mark_layer_dirty_(LAYER_STATUS, old);
+  mark_group_dirty_(LAYER_STATUS, status_group_);
 }
 
 void ARGBStripComponent::set_arm_select_mode_by_name(const char *name) {
@@ -294,48 +1135,20 @@ void ARGBStripComponent::set_arm_select_mode_by_name(const char *name) {
   set_arm_select_mode(m);
 }
 
-void ARGBStripComponent::apply_pending_for_group_(const std::string &group) {
-  auto it = pending_writes_.find(group);
-  if (it == pending_writes_.end()) return;
-  auto &pend = it->second;
-  if (!pend.used) return;
-  auto g = get_group(group);
-  if (!g) return;
-
-  for (int led : *g) {
-    if (led < 0 || (uint16_t)led >= num_leds_) continue;
-    uint32_t base = led * 3;
-    if (pend.channel_set[0]) base_raw_grb_[base + 1] = pend.values[0];
-    if (pend.channel_set[1]) base_raw_grb_[base + 0] = pend.values[1];
-    if (pend.channel_set[2]) base_raw_grb_[base + 2] = pend.values[2];
-  }
-  pend.used = false;
-  pend.channel_set = {false,false,false};
-  if (!rfid_visual_active_()) mark_dirty_();
-}
-
 // Helpers
-std::string ARGBStripComponent::get_arm_select_group_name_() const {
-  switch (arm_select_mode_) {
-    case ArmSelectMode::AWAY: return "away";
-    case ArmSelectMode::HOME: return "home";
-    case ArmSelectMode::DISARM: return "disarm";
+uint8_t ARGBStripComponent::arm_select_group_id_(ArmSelectMode m) const {
+  switch (m) {
+    case ArmSelectMode::AWAY: return arm_group_ids_[ARM_SLOT_AWAY];
+    case ArmSelectMode::HOME: return arm_group_ids_[ARM_SLOT_HOME];
+    case ArmSelectMode::DISARM: return arm_group_ids_[ARM_SLOT_DISARM];
     case ArmSelectMode::NIGHT:
     case ArmSelectMode::VACATION:
     case ArmSelectMode::BYPASS:
-    case ArmSelectMode::ACTION: return "custom";
-    default: return "";
+    case ArmSelectMode::ACTION: return arm_group_ids_[ARM_SLOT_CUSTOM];
+    default: return NO_GROUP;
   }
 }
 
-int ARGBStripComponent::get_arm_select_led_index_() const {
-  std::string gname = get_arm_select_group_name_();
-  if (gname.empty()) return -1;
-  auto g = get_group(gname);
-  if (!g || g->empty()) return -1;
-  return (*g)[0];
-}
-
 bool ARGBStripComponent::rfid_visual_active_() const {
   if (strip_mode_ != StripMode::RFID_PROGRAM) return false;
   return (rfid_transition_ == RfidTransitionState::FADE_IN ||
@@ -343,92 +1156,265 @@ bool ARGBStripComponent::rfid_visual_active_() const {
           rfid_transition_ == RfidTransitionState::FADE_OUT);
 }
 
-float ARGBStripComponent::current_rfid_fade_factor_() const {
-  if (!rfid_visual_active_()) return 0.0f;
+uint32_t ARGBStripComponent::current_rfid_fade_q16_() const {
+  if (!rfid_visual_active_()) return 0;
   uint32_t now = millis();
   uint32_t elapsed = now - rfid_transition_start_ms_;
+  uint32_t ramp = (elapsed >= RFID_FADE_MS) ? FADE_Q16_ONE
+                                            : (elapsed * FADE_Q16_ONE + RFID_FADE_MS / 2) / RFID_FADE_MS;
   if (rfid_transition_ == RfidTransitionState::FADE_IN) {
-    if (elapsed >= RFID_FADE_MS) return 1.0f;
-    return (float)elapsed / (float)RFID_FADE_MS;
+    return ramp;
   } else if (rfid_transition_ == RfidTransitionState::ACTIVE) {
-    return 1.0f;
+    return FADE_Q16_ONE;
   } else if (rfid_transition_ == RfidTransitionState::FADE_OUT) {
-    if (elapsed >= RFID_FADE_MS) return 0.0f;
-    return 1.0f - (float)elapsed / (float)RFID_FADE_MS;
+    return FADE_Q16_ONE - ramp;
   }
-  return 0.0f;
+  return 0;
 }
 
 // Recomposition
+// Rebuilds the union of the layers' dirty ranges. Layers below the topmost
+// opaque layer covering that range are skipped; the animated RFID takeover
+// always spans the whole strip.
 void ARGBStripComponent::recomposite_() {
-  if (rfid_visual_active_()) {
-    float f = current_rfid_fade_factor_();
-    build_rainbow_frame_(f);
-  } else {
-    build_normal_base_();
-    if (arm_select_mode_ != ArmSelectMode::NONE || arm_select_disable_pending_) {
-      apply_arm_select_overlay_();
+  LedRange r;
+  bool status_stale = !layers_[LAYER_STATUS].dirty.empty();
+  for (auto &layer : layers_) {
+    r.add(layer.dirty);
+    layer.dirty.clear();
+  }
+  if (layers_[LAYER_RFID].enabled) {
+    r.lo = 0;
+    r.hi = num_leds_;
+  }
+  if (r.empty()) return;
+
+  uint8_t bottom = LAYER_BASE;
+  for (uint8_t l = LAYER_COUNT - 1; l > LAYER_BASE; l--) {
+    if (layers_[l].enabled && layers_[l].opaque() && layer_covers_(l, r)) {
+      bottom = l;
+      break;
     }
   }
-  apply_group_caps_();
+  // Outside its fades the RFID takeover is a pure function of time: play it
+  // back from the cache, already scaled.
+  if (bottom == LAYER_RFID && frame_cache_enabled_ && current_rfid_fade_q16_() >= FADE_Q16_ONE) {
+    const uint8_t *frame = rfid_cached_frame_(millis() - rainbow_start_ms_);
+    if (frame) {
+      memcpy(working_grb_.data(), frame, rfid_cache_.frame_bytes);
+      send_range_.add(r);
+      return;
+    }
+  }
+  for (uint8_t l = bottom; l < LAYER_COUNT; l++) {
+    if (!layers_[l].enabled) continue;
+    switch (l) {
+      case LAYER_BASE:
+        compose_base_(working_grb_.data(), r, millis());
+        break;
+      case LAYER_EFFECTS:
+        apply_effects_(r);
+        break;
+      case LAYER_STATUS:
+        if (status_stale) render_status_layer_();
+        blend_group_(status_group_, status_pixels_.data(), r, layers_[LAYER_STATUS]);
+        break;
+      case LAYER_KEYPAD:
+        apply_keypad_layer_(r, millis());
+        break;
+      case LAYER_RFID:
+        apply_rfid_layer_(r);
+        break;
+    }
+  }
+  apply_group_caps_(working_grb_.data(), r);
+  send_range_.add(r);
 }
 
-void ARGBStripComponent::build_normal_base_() {
-  working_grb_ = base_raw_grb_;
+// src holds the group's pixels in group order; only LEDs inside r are touched.
+void ARGBStripComponent::blend_group_(uint8_t group, const uint8_t *src, const LedRange &r, const Layer &layer) {
+  if (group >= groups_.size()) return;
+  const auto &grp = groups_[group];
+  if (grp.hi <= r.lo || grp.lo >= r.hi) return;
+  bool alpha = layer.blend == BlendMode::ALPHA;
+  for (const auto &run : grp.runs) {
+    uint16_t lo = std::max(run.start, r.lo);
+    uint16_t hi = std::min<uint16_t>(run.start + run.len, r.hi);
+    if (lo < hi) blend_pixels(&working_grb_[lo * BPP], src + (lo - run.start) * BPP, hi - lo, alpha, layer.opacity_q16);
+    src += run.len * BPP;
+  }
 }
 
-void ARGBStripComponent::build_rainbow_frame_(float fade_factor) {
+// The rainbow replaces the whole strip; during its fades it is scaled
+// from black rather than mixed over the normal frame.
+void ARGBStripComponent::apply_rfid_layer_(const LedRange &r) {
   if (num_leds_ == 0) return;
-  working_grb_.assign(num_leds_ * 3, 0);
-  if (fade_factor <= 0.0f) return;
+  uint32_t fade = current_rfid_fade_q16_();
+  uint8_t *px = working_grb_.data();
+  if (fade < FADE_Q16_ONE) memset(px, 0, num_leds_ * BPP);
+  if (fade == 0) return;
   uint32_t now = millis();
-  uint32_t elapsed = now - rainbow_start_ms_;
-  float base_h = fmodf((float)elapsed / (float)rainbow_cycle_ms_, 1.0f);
-  for (uint16_t i = 0; i < num_leds_; i++) {
-    float h = fmodf(base_h + (float)i / (float)num_leds_, 1.0f);
-    uint8_t g,r,b;
-    hsv_to_grb_(h, 1.0f, 1.0f, g, r, b);
-    if (fade_factor < 0.999f) {
-      g = (uint8_t)(g * fade_factor + 0.5f);
-      r = (uint8_t)(r * fade_factor + 0.5f);
-      b = (uint8_t)(b * fade_factor + 0.5f);
-    }
-    uint32_t idx = i * 3;
-    working_grb_[idx + 0] = g;
-    working_grb_[idx + 1] = r;
-    working_grb_[idx + 2] = b;
-  }
-}
-
-void ARGBStripComponent::apply_arm_select_overlay_() {
-  if (arm_select_mode_ == ArmSelectMode::NONE && !arm_select_disable_pending_)
-    return;
-  if (rfid_visual_active_()) return;
+  HueSweep sweep(hue_phase_fp(now - rainbow_start_ms_, rainbow_cycle_ms_), num_leds_);
+  uint8_t hue[BPP];
+  for (uint16_t i = 0; i < num_leds_; i++, px += BPP) {
+    hue_to_pixel(sweep.next(), hue);
+    blend_pixels(px, hue, 1, fade < FADE_Q16_ONE, fade);
+  }
+}
+
+// Keypress feedback
+void ARGBStripComponent::key_feedback(bool digit) {
+  const auto &fb = key_feedback_;
+  if (fb.mode == KeyFeedbackMode::NONE || fb.group >= groups_.size()) return;
+  if (fb.mode == KeyFeedbackMode::DIGITS) {
+    if (!digit) return;
+    if (key_digits_ < groups_[fb.group].count) key_digits_++;
+  }
+  key_feedback_start_ms_ = millis();
+  layers_[LAYER_KEYPAD].enabled = true;
+  mark_group_dirty_(LAYER_KEYPAD, fb.group);
+}
+
+void ARGBStripComponent::key_feedback_reset() {
+  if (key_feedback_.mode != KeyFeedbackMode::DIGITS || !layers_[LAYER_KEYPAD].enabled) return;
+  key_digits_ = 0;
+  layers_[LAYER_KEYPAD].enabled = false;
+  mark_group_dirty_(LAYER_KEYPAD, key_feedback_.group);
+}
+
+bool ARGBStripComponent::keypad_animating_() const {
+  return layers_[LAYER_KEYPAD].enabled &&
+         (key_feedback_.mode == KeyFeedbackMode::FLASH || key_feedback_.mode == KeyFeedbackMode::RIPPLE);
+}
+
+// Mix weight (0..256) of the feedback colour for the LED at group position
+// index, t ms after the key press.
+uint16_t ARGBStripComponent::keypad_level_(uint16_t index, uint16_t count, uint32_t t) const {
+  uint32_t dur = key_feedback_.duration_ms ? key_feedback_.duration_ms : 1;
+  if (t >= dur) t = dur;
+  uint32_t fade = 256 - t * 256 / dur;
+  switch (key_feedback_.mode) {
+    case KeyFeedbackMode::FLASH:
+      return (uint16_t) fade;
+    case KeyFeedbackMode::RIPPLE: {
+      // Half-LED units: the ring leaves the middle and reaches both ends
+      // at the end of the duration, two LEDs wide and dimming as it goes.
+      int32_t dist = std::abs(2 * (int32_t) index - (int32_t)(count - 1));
+      int32_t radius = (int32_t)(t * (count + 1) / dur);
+      int32_t off = std::abs(dist - radius);
+      if (off >= 4) return 0;
+      return (uint16_t)((256 - off * 64) * fade >> 8);
+    }
+    case KeyFeedbackMode::DIGITS:
+      return index < key_digits_ ? 256 : 0;
+    default:
+      return 0;
+  }
+}
+
+void ARGBStripComponent::apply_keypad_layer_(const LedRange &r, uint32_t now) {
+  const auto &fb = key_feedback_;
+  if (fb.group >= groups_.size()) return;
+  const auto &grp = groups_[fb.group];
+  if (grp.hi <= r.lo || grp.lo >= r.hi) return;
+  uint32_t t = now - key_feedback_start_ms_;
+  uint8_t color[BPP];
+  Pixel::set_rgb(color, fb.r, fb.g, fb.b);
+  uint16_t index = 0;
+  for (const auto &run : grp.runs) {
+    for (uint16_t k = 0; k < run.len; k++, index++) {
+      uint16_t led = run.start + k;
+      if (led < r.lo || led >= r.hi) continue;
+      uint16_t level = keypad_level_(index, grp.count, t);
+      if (level) kernels::blend(&working_grb_[led * BPP], color, BPP, (uint32_t) level << 8);
+    }
+  }
+}
+
+// Frame cache
+bool ARGBStripComponent::alloc_frame_cache_(FrameCache &cache, size_t frame_bytes, uint32_t cycle_ms) {
+  if (cache.unavailable) return false;
+  uint16_t frames = (uint16_t) std::max<uint32_t>(1, cycle_ms / frame_interval_ms_);
+  if (cache.data && cache.frame_bytes == frame_bytes && cache.frames == frames) {
+    cache.cycle_ms = cycle_ms;
+    return true;
+  }
+  if (cache.data) heap_caps_free(cache.data);
+  size_t bytes = frame_bytes * frames;
+  cache.data = (uint8_t *) heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+  cache.in_psram = cache.data != nullptr;
+  if (!cache.data && bytes <= FRAME_CACHE_RAM_MAX)
+    cache.data = (uint8_t *) heap_caps_malloc(bytes, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+  if (!cache.data) {
+    ESP_LOGW(TAG, "Frame cache of %u B does not fit (no PSRAM?), rendering live", (unsigned) bytes);
+    cache.unavailable = true;
+    return false;
+  }
+  cache.frame_bytes = frame_bytes;
+  cache.frames = frames;
+  cache.cycle_ms = cycle_ms;
+  ESP_LOGD(TAG, "Frame cache: %u frames x %u B in %s", (unsigned) frames, (unsigned) frame_bytes,
+           cache.in_psram ? "PSRAM" : "RAM");
+  return true;
+}
+
+const uint8_t *ARGBStripComponent::rfid_cached_frame_(uint32_t elapsed) {
+  if (scaling_luts_dirty_ || led_lut_.size() != num_leds_) rebuild_scaling_luts_();
+  FrameCache &cache = rfid_cache_;
+  if (!cache.valid) {
+    if (num_leds_ == 0 || !alloc_frame_cache_(cache, num_leds_ * BPP, rainbow_cycle_ms_)) return nullptr;
+    LedRange all{0, num_leds_};
+    for (uint16_t k = 0; k < cache.frames; k++) {
+      uint8_t *px = cache.data + k * cache.frame_bytes;
+      uint32_t t = (uint32_t)((uint64_t) k * cache.cycle_ms / cache.frames);
+      HueSweep sweep(hue_phase_fp(t, cache.cycle_ms), num_leds_);
+      for (uint16_t i = 0; i < num_leds_; i++) hue_to_pixel(sweep.next(), px + i * BPP);
+      apply_group_caps_(px, all);
+    }
+    cache.valid = true;
+  }
+  return cache.frame_at(elapsed);
+}
+
+const uint8_t *ARGBStripComponent::action_cached_frame_(uint32_t elapsed) {
+  FrameCache &cache = action_cache_;
+  uint8_t id = arm_group_ids_[ARM_SLOT_CUSTOM];
+  if (id >= groups_.size() || groups_[id].count == 0) return nullptr;
+  if (!cache.valid) {
+    uint16_t count = groups_[id].count;
+    if (!alloc_frame_cache_(cache, count * BPP, ACTION_RAINBOW_CYCLE_MS)) return nullptr;
+    for (uint16_t k = 0; k < cache.frames; k++) {
+      uint8_t *px = cache.data + k * cache.frame_bytes;
+      uint32_t t = (uint32_t)((uint64_t) k * cache.cycle_ms / cache.frames);
+      HueSweep sweep(hue_phase_fp(t, cache.cycle_ms), count);
+      for (uint16_t i = 0; i < count; i++) hue_to_pixel(sweep.next(), px + i * BPP);
+    }
+    cache.valid = true;
+  }
+  return cache.frame_at(elapsed);
+}
+
+void ARGBStripComponent::render_status_layer_() {
+  if (status_group_ >= groups_.size() || status_pixels_.empty()) return;
+  const auto &grp = groups_[status_group_];
 
   // ACTION rainbow mode
   if (arm_select_mode_ == ArmSelectMode::ACTION) {
-    const std::string group_name = "custom";
-    const auto *grp = get_group(group_name);
-    if (!grp || grp->empty()) return;
     uint32_t now = millis();
-    float base = (float)((now - action_rainbow_start_ms_) % ACTION_RAINBOW_CYCLE_MS) / (float)ACTION_RAINBOW_CYCLE_MS;
-    for (size_t idx = 0; idx < grp->size(); ++idx) {
-      int led = (*grp)[idx];
-      if (led < 0 || (uint16_t)led >= num_leds_) continue;
-      float h = fmodf(base + (float)idx / (float)grp->size(), 1.0f);
-      uint8_t g,r,b;
-      hsv_to_grb_(h, 1.0f, 1.0f, g, r, b);
-      uint32_t base_i = led * 3;
-      working_grb_[base_i + 0] = g;
-      working_grb_[base_i + 1] = r;
-      working_grb_[base_i + 2] = b;
+    if (frame_cache_enabled_) {
+      const uint8_t *frame = action_cached_frame_(now - action_rainbow_start_ms_);
+      if (frame && action_cache_.frame_bytes == status_pixels_.size()) {
+        memcpy(status_pixels_.data(), frame, status_pixels_.size());
+        return;
+      }
     }
+    HueSweep sweep(hue_phase_fp(now - action_rainbow_start_ms_, ACTION_RAINBOW_CYCLE_MS), grp.count);
+    uint8_t *px = status_pixels_.data();
+    for (uint16_t i = 0; i < grp.count; i++, px += BPP) hue_to_pixel(sweep.next(), px);
     return;
   }
 
-  // Existing flash logic
-  int led_index = get_arm_select_led_index_();
-  if (led_index < 0) return;
+  // Flash the group's first LED; the rest keep their held colours.
   uint32_t now = millis();
   uint32_t phase = (now % (FLASH_ON_MS + FLASH_OFF_MS));
   bool on_phase = phase < FLASH_ON_MS;
@@ -440,15 +1426,10 @@ void ARGBStripComponent::apply_arm_select_overlay_() {
     default: break;
   }
 
-  uint32_t base = led_index * 3;
   if (on_phase) {
-    working_grb_[base + 0] = flash_g;
-    working_grb_[base + 1] = flash_r;
-    working_grb_[base + 2] = flash_b;
+    Pixel::set_rgb(status_pixels_.data(), flash_r, flash_g, flash_b);
   } else {
-    working_grb_[base + 0] = 0;
-    working_grb_[base + 1] = 0;
-    working_grb_[base + 2] = 0;
+    Pixel::set_rgb(status_pixels_.data(), 0, 0, 0);
   }
 }
 
@@ -462,94 +1443,185 @@ void ARGBStripComponent::build_gamma_lut_if_needed_() {
   }
 }
 
-void ARGBStripComponent::apply_group_caps_() {
-  build_gamma_lut_if_needed_();
-  for (auto &kv : groups_) {
-    uint16_t cap = get_group_cap(kv.first);
+void ARGBStripComponent::build_group_lut_(uint16_t cap, uint8_t *lut) const {
+  for (int v = 0; v < 256; v++) {
+    uint8_t out = (uint8_t) v;
     if (cap == 0) {
-      // All off
-      for (int led : kv.second) {
-        if (led < 0 || (uint16_t)led >= num_leds_) continue;
-        uint32_t base = led * 3;
-        working_grb_[base+0]=0; working_grb_[base+1]=0; working_grb_[base+2]=0;
+      out = 0;
+    } else {
+      switch (scaling_mode_) {
+        case ScalingMode::LINEAR:
+          out = (uint8_t)( (uint32_t)v * cap / 255 );
+          break;
+        case ScalingMode::CLAMP:
+          if (v > cap) out = (uint8_t) cap;
+          break;
+        case ScalingMode::PERCEPTUAL:
+          // Apply perceptual curve then scale to cap
+          out = (uint8_t)((uint32_t)gamma_lut_[v] * cap / 255);
+          break;
       }
-      continue;
-    }
-    if (cap >= 255 && scaling_mode_ == ScalingMode::LINEAR) {
-      // No change needed in pure linear full-bright case
-      continue;
     }
+    lut[v] = out;
+  }
+}
+
+void ARGBStripComponent::rebuild_scaling_luts_() {
+  build_gamma_lut_if_needed_();
+  scaling_luts_dirty_ = false;
+  rfid_cache_.valid = false;  // cached RFID frames are stored scaled
+  scaling_luts_.clear();
+  led_lut_.assign(num_leds_, LUT_NONE);
 
-    for (int led : kv.second) {
-      if (led < 0 || (uint16_t)led >= num_leds_) continue;
-      uint32_t base = led * 3;
-      for (int c=0;c<3;c++) {
-        uint8_t v = working_grb_[base + c];
-        uint8_t out = v;
-        switch (scaling_mode_) {
-          case ScalingMode::LINEAR:
-            out = (uint8_t)( (uint32_t)v * cap / 255 );
-            break;
-          case ScalingMode::CLAMP:
-            if (v > cap) out = (uint8_t) cap;
-            break;
-          case ScalingMode::PERCEPTUAL: {
-            // Apply perceptual curve then scale to cap
-            uint8_t p = gamma_lut_[v];  // p in 0..255 perceptual
-            out = (uint8_t)((uint32_t)p * cap / 255);
-            break;
-          }
-        }
-        working_grb_[base + c] = out;
+  // An LED in several groups gets the composition of their LUTs, applied
+  // in group name order as the name-keyed group map used to. Identical
+  // compositions share one table.
+  std::vector<uint8_t> order(groups_.size());
+  for (size_t gi = 0; gi < order.size(); gi++) order[gi] = (uint8_t) gi;
+  std::sort(order.begin(), order.end(), [this](uint8_t a, uint8_t b) { return groups_[a].name < groups_[b].name; });
+  std::map<std::pair<uint8_t, uint8_t>, uint8_t> composed;
+  std::array<uint8_t, 256> group_lut;
+  for (uint8_t gi : order) {
+    const auto &grp = groups_[gi];
+    if (grp.cap >= 255 && scaling_mode_ == ScalingMode::LINEAR) continue;  // identity
+    build_group_lut_(grp.cap, group_lut.data());
+
+    for_each_led_(grp, [&](uint16_t led) {
+      uint8_t prev = led_lut_[led];
+      auto key = std::make_pair(prev, gi);
+      auto it = composed.find(key);
+      if (it != composed.end()) {
+        led_lut_[led] = it->second;
+        return;
       }
-    }
+      if (scaling_luts_.size() >= LUT_NONE) {
+        ESP_LOGW(TAG, "Too many distinct scaling LUTs, LED %u keeps its previous scaling", led);
+        return;
+      }
+      std::array<uint8_t, 256> lut;
+      for (int v = 0; v < 256; v++) {
+        uint8_t in = (prev == LUT_NONE) ? (uint8_t) v : scaling_luts_[prev][v];
+        lut[v] = group_lut[in];
+      }
+      uint8_t idx = (uint8_t) scaling_luts_.size();
+      scaling_luts_.push_back(lut);
+      composed[key] = idx;
+      led_lut_[led] = idx;
+    });
   }
+  ESP_LOGD(TAG, "Scaling LUTs rebuilt: %u tables", (unsigned) scaling_luts_.size());
 }
 
-// Send
-void ARGBStripComponent::send_frame_() {
-  if (!rmt_ready_ || num_leds_ == 0) return;
-  bool changed = false;
-  for (size_t i=0;i<working_grb_.size(); i++) {
-    if (working_grb_[i] != last_sent_grb_[i]) { changed = true; break; }
+void ARGBStripComponent::apply_group_caps_(uint8_t *grb, const LedRange &r) {
+  if (scaling_luts_dirty_ || led_lut_.size() != num_leds_) rebuild_scaling_luts_();
+  if (scaling_luts_.empty()) return;
+
+  // Neighbouring LEDs usually share a group, so each run of one LUT goes
+  // through the kernel in a single call.
+  const uint8_t *lut_idx = led_lut_.data();
+  uint16_t i = r.lo;
+  while (i < r.hi) {
+    uint8_t li = lut_idx[i];
+    uint16_t j = i + 1;
+    while (j < r.hi && lut_idx[j] == li) j++;
+    if (li != LUT_NONE) kernels::lut_apply(grb + i * BPP, (size_t)(j - i) * BPP, scaling_luts_[li].data());
+    i = j;
+  }
+}
+
+// Memory
+void ARGBStripComponent::log_memory_report_() {
+  size_t frame = (size_t) num_leds_ * BPP;
+  // last_sent_grb_ is reported under change detection only.
+  size_t buffers = base_raw_grb_.capacity() + working_grb_.capacity();
+  size_t change_detect = compact_ ? sizeof(last_sent_hash_) : last_sent_grb_.capacity();
+  size_t group_bytes = legacy_group_.capacity() * sizeof(int), legacy_group_bytes = 0;
+  for (const auto &g : groups_) {
+    group_bytes += sizeof(StripGroup) + g.runs.capacity() * sizeof(LedRun) + g.name.capacity();
+    legacy_group_bytes += sizeof(StripGroup) + g.count * sizeof(int) + g.name.capacity();
+  }
+  size_t lut_bytes = scaling_luts_.capacity() * 256 + led_lut_.capacity();
+  size_t effect_bytes = status_pixels_.capacity();
+  size_t scene_bytes = fade_from_.capacity() + fade_shown_.capacity() + fades_.capacity() * sizeof(BaseFade);
+  for (const auto &s : scenes_) scene_bytes += sizeof(StripScene) + s.grb.capacity() + s.name.capacity();
+  for (const auto &e : effects_) effect_bytes += sizeof(ActiveEffect) + e.pixels.capacity();
+  size_t rmt_bytes = 0;
+  for (const auto &out : outputs_) {
+    rmt_bytes += backend_ == OutputBackend::SPI ? out.spi_len : (out.dma ? 1024 : 64) * sizeof(rmt_symbol_word_t);
+  }
+  size_t cache_ram = 0, cache_psram = 0;
+  for (const FrameCache *fc : {&rfid_cache_, &action_cache_}) {
+    if (!fc->data) continue;
+    (fc->in_psram ? cache_psram : cache_ram) += fc->frame_bytes * fc->frames;
   }
-  if (!changed) return;
 
-  esp_err_t err = rmt_transmit(tx_channel_, bytes_encoder_, working_grb_.data(), working_grb_.size(), &tx_cfg_);
-  if (err != ESP_OK) return;
-  if (rmt_tx_wait_all_done(tx_channel_, pdMS_TO_TICKS(20)) != ESP_OK) return;
-  err = rmt_transmit(tx_channel_, copy_encoder_, &reset_symbol_, sizeof(reset_symbol_), &tx_cfg_);
-  if (err == ESP_OK) {
-    rmt_tx_wait_all_done(tx_channel_, pdMS_TO_TICKS(10));
+  ESP_LOGCONFIG(TAG, "  Memory (%s mode):", compact_ ? "compact" : "standard");
+  ESP_LOGCONFIG(TAG, "    Frame buffers: %u B (frame=%u B)", (unsigned) buffers, (unsigned) frame);
+  ESP_LOGCONFIG(TAG, "    Change detection: %u B%s", (unsigned) change_detect,
+                compact_ ? " (32-bit hash)" : " (last-sent copy)");
+  ESP_LOGCONFIG(TAG, "    Groups: %u B (index lists would use %u B)", (unsigned) group_bytes,
+                (unsigned) legacy_group_bytes);
+  ESP_LOGCONFIG(TAG, "    Scaling LUTs: %u B, effect/status layers: %u B, %s: %u B", (unsigned) lut_bytes,
+                (unsigned) effect_bytes, backend_ == OutputBackend::SPI ? "SPI DMA buffers" : "RMT symbols",
+                (unsigned) rmt_bytes);
+  if (!scenes_.empty() || scene_bytes) {
+    ESP_LOGCONFIG(TAG, "    Scenes and crossfade: %u B", (unsigned) scene_bytes);
+  }
+  if (frame_cache_enabled_) {
+    ESP_LOGCONFIG(TAG, "    Frame cache: %u B RAM, %u B PSRAM", (unsigned) cache_ram, (unsigned) cache_psram);
+  }
+  if (compact_) {
+    ESP_LOGCONFIG(TAG, "    Saved vs standard: %u B", (unsigned)(frame - sizeof(last_sent_hash_) +
+                  (legacy_group_bytes > group_bytes ? legacy_group_bytes - group_bytes : 0)));
   }
-  last_sent_grb_ = working_grb_;
 }
 
-// Color util
-void ARGBStripComponent::hsv_to_grb_(float h, float s, float v, uint8_t &g, uint8_t &r, uint8_t &b) const {
-  if (s <= 0.0f) {
-    uint8_t val = (uint8_t)(v * 255.0f + 0.5f);
-    g = r = b = val;
+// Send
+void ARGBStripComponent::send_frame_() {
+  if (!output_ready_ || num_leds_ == 0 || send_range_.empty()) return;
+  if (compact_) {
+    // loop() already waited for the previous frame before recompositing.
+    send_range_.clear();
+    uint32_t h = frame_hash(working_grb_.data(), working_grb_.size());
+    if (last_sent_hash_valid_ && h == last_sent_hash_) return;
+    if (!transmit_outputs_(working_grb_.data())) {
+      // Resend the whole frame next loop; some outputs may have taken it.
+      last_sent_hash_valid_ = false;
+      send_range_.add(0, num_leds_);
+      frame_dirty_ = true;
+      return;
+    }
+    last_sent_hash_ = h;
+    last_sent_hash_valid_ = true;
+    return;
+  }
+  // Until a frame has gone out whole, last_sent_grb_ says nothing about the
+  // strip, so the whole frame is copied and sent.
+  if (!last_sent_valid_) send_range_.add(0, num_leds_);
+  size_t lo = send_range_.lo * BPP;
+  size_t len = (send_range_.hi - send_range_.lo) * BPP;
+  if (last_sent_valid_ && kernels::equal(working_grb_.data() + lo, last_sent_grb_.data() + lo, len)) {
+    send_range_.clear();
+    return;
+  }
+
+  // The RMT driver reads the pixel buffer while the frame is on the wire, so
+  // we transmit from last_sent_grb_ and only wait when the next frame needs it.
+  // send_range_ is kept, so the retry on the next loop resends it.
+  if (!wait_tx_idle_(20)) {
+    frame_dirty_ = true;
+    return;
+  }
+  memcpy(last_sent_grb_.data() + lo, working_grb_.data() + lo, len);
+  send_range_.clear();
+  if (!transmit_outputs_(last_sent_grb_.data())) {
+    // Resend the whole frame next loop; some outputs may have taken it.
+    last_sent_valid_ = false;
+    send_range_.add(0, num_leds_);
+    frame_dirty_ = true;
     return;
   }
-  h = fmodf(h, 1.0f) * 6.0f;
-  int i = (int) floorf(h);
-  float f = h - i;
-  float p = v * (1.0f - s);
-  float q = v * (1.0f - s * f);
-  float t = v * (1.0f - s * (1.0f - f));
-  float rf,gf,bf;
-  switch (i) {
-    case 0: rf=v; gf=t; bf=p; break;
-    case 1: rf=q; gf=v; bf=p; break;
-    case 2: rf=p; gf=v; bf=t; break;
-    case 3: rf=p; gf=q; bf=v; break;
-    case 4: rf=t; gf=p; bf=v; break;
-    default: rf=v; gf=p; bf=q; break;
-  }
-  r = (uint8_t)(rf * 255.0f + 0.5f);
-  g = (uint8_t)(gf * 255.0f + 0.5f);
-  b = (uint8_t)(bf * 255.0f + 0.5f);
+  last_sent_valid_ = true;
 }
 
 // Output channel
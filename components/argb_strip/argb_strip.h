@@ -2,8 +2,13 @@
 #include "esphome/core/component.h"
 #include "esphome/core/hal.h"
 #include "esphome/core/gpio.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/automation.h"
+#include "esphome/core/preferences.h"
 #include "esphome/components/output/float_output.h"
-#include <map>
+#include "effects.h"
+#include "pixel_format.h"
+#include <memory>
 #include <vector>
 #include <string>
 #include <cstdint>
@@ -16,6 +21,8 @@
 #endif
 #include "driver/rmt_tx.h"
 #include "driver/rmt_encoder.h"
+#include "driver/spi_master.h"
+#include "soc/soc_caps.h"
 
 namespace esphome {
 namespace argb_strip {
@@ -45,6 +52,40 @@ enum class RfidTransitionState : uint8_t {
   FADE_OUT
 };
 
+// RMT drives each output from its own channel. SPI clocks pre-encoded
+// pixel bits out of a DMA buffer and leaves the RMT channels free.
+enum class OutputBackend : uint8_t {
+  RMT = 0,
+  SPI
+};
+
+// Where the last committed base frame is kept so setup() can show it
+// before the network is up. RTC memory survives software resets, OTA
+// reboots and panics; FLASH adds a debounced copy in preferences for power
+// loss. The arm-select overlay is never restored.
+enum class FrameRestore : uint8_t {
+  NONE = 0,
+  RTC,
+  FLASH
+};
+
+// Local keypress feedback on one group, driven in-process by k1_uart.
+// FLASH fades the group from colour, RIPPLE sends a ring out from its
+// middle, DIGITS lights one LED per PIN digit entered.
+enum class KeyFeedbackMode : uint8_t {
+  NONE = 0,
+  FLASH,
+  RIPPLE,
+  DIGITS
+};
+
+struct KeyFeedbackConfig {
+  uint8_t group;
+  KeyFeedbackMode mode;
+  uint8_t r, g, b;
+  uint32_t duration_ms;  // FLASH/RIPPLE length; DIGITS idle timeout
+};
+
 enum class ScalingMode : uint8_t {
   LINEAR = 0,
   CLAMP,
@@ -56,15 +97,70 @@ class ARGBStripComponent : public Component {
   void set_pin(GPIOPin *pin) { pin_ = pin; }
   void set_raw_gpio(int raw) { raw_gpio_ = raw; }
   void set_num_leds(uint16_t n) { num_leds_ = n; }
+  // Further outputs on their own GPIOs. Their LEDs continue the numbering
+  // after the first strip, so groups may span outputs; all outputs share
+  // the compositor and are transmitted together. Call after set_num_leds.
+  void add_segment(GPIOPin *pin, int raw_gpio, uint16_t num_leds);
   void set_rfid_rainbow_cycle_ms(uint32_t v) { rainbow_cycle_ms_ = v; }
+  void set_use_dma(bool v) { use_dma_ = v; }
+  void set_backend(OutputBackend b) { backend_ = b; }
+  void set_restore_frame(FrameRestore r) { restore_frame_ = r; }
+  void set_effect_budget_us(uint32_t v) { effect_budget_us_ = v; }
+  void set_compact(bool v) { compact_ = v; }
+  void set_frame_cache(bool v) { frame_cache_enabled_ = v; }
+  void set_max_fps(uint32_t fps) { frame_interval_ms_ = fps ? 1000 / fps : 40; }
   void set_scaling_mode(const std::string &m);
-  void set_perceptual_gamma(float g) { perceptual_gamma_ = g; build_gamma_lut_ = true; }
-
-  void add_group(const std::string &name, const std::vector<int> &leds, uint16_t cap);
+  void set_perceptual_gamma(float g) { perceptual_gamma_ = g; build_gamma_lut_ = true; scaling_luts_dirty_ = true; }
+
+  // Group ids are dense indices assigned at codegen time (see __init__.py).
+  void add_group(uint8_t id, const std::string &name, const std::vector<uint16_t> &leds, uint16_t cap);
+  uint8_t find_group(const std::string &name) const;
+  uint16_t group_size(uint8_t id) const;
+  // Expands the group's runs into the LED list groups used to be stored as.
+  // The pointer stays valid until the next call.
+  ESPDEPRECATED("get_group() copies the group on every call; use find_group() and group_size()", "2026.10.0")
   const std::vector<int> *get_group(const std::string &name) const;
-  uint16_t get_group_cap(const std::string &name) const;
-
-  void update_group_channel(const std::string &group, uint8_t channel, uint8_t value);
+  uint16_t get_group_cap(uint8_t id) const;
+  uint16_t get_group_cap(const std::string &name) const { return get_group_cap(find_group(name)); }
+  void set_group_cap(uint8_t id, uint16_t cap);
+
+  // channel: 0=r, 1=g, 2=b, 3=w (RGBW pixel formats only).
+  void update_group_channel(uint8_t group, uint8_t channel, uint8_t value);
+  // Whole-colour write used by the light platform: one pass, one dirty mark.
+  // White is ignored unless the pixel format has a white channel.
+  void set_group_rgbw(uint8_t group, uint8_t r, uint8_t g, uint8_t b, uint8_t w);
+  void set_group_rgb(uint8_t group, uint8_t r, uint8_t g, uint8_t b) { set_group_rgbw(group, r, g, b, 0); }
+  // Fades from what is shown now to the target over duration_ms. The strip
+  // interpolates once per displayed frame; 0 ms writes immediately.
+  void transition_group_rgbw(uint8_t group, uint8_t r, uint8_t g, uint8_t b, uint8_t w, uint32_t duration_ms);
+  void transition_group_rgb(uint8_t group, uint8_t r, uint8_t g, uint8_t b, uint32_t duration_ms) {
+    transition_group_rgbw(group, r, g, b, 0, duration_ms);
+  }
+  void transition_frame(const uint8_t *grb, uint32_t duration_ms);  // num_leds * BPP bytes, wire order
+  // Name-based variant for lambdas; resolves the id on every call.
+  void update_group_channel(const std::string &group, uint8_t channel, uint8_t value) {
+    update_group_channel(find_group(group), channel, value);
+  }
+
+  static constexpr uint8_t NO_GROUP = 0xFF;
+
+  // Scenes capture the whole base frame. Recall swaps it in at once, or
+  // crossfades from what is currently shown over transition_ms.
+  void add_scene(uint8_t id, const std::string &name, bool restore);
+  uint8_t find_scene(const std::string &name) const;
+  bool save_scene(uint8_t id);
+  bool recall_scene(uint8_t id, uint32_t transition_ms = 0);
+
+  // Effects replace a group's base colour until cleared.
+  void set_group_effect(uint8_t group, EffectType type, const EffectParams &params);
+  void clear_group_effect(uint8_t group);
+
+  // One key press; digit presses advance the DIGITS count. Shown on the
+  // next loop, without waiting for the frame interval.
+  void set_key_feedback(const KeyFeedbackConfig &cfg) { key_feedback_ = cfg; }
+  void key_feedback(bool digit);
+  // PIN submitted or abandoned: clears the DIGITS indicator.
+  void key_feedback_reset();
 
   void enable_rfid_mode();
   void disable_rfid_mode();
@@ -84,20 +180,101 @@ class ARGBStripComponent : public Component {
   int raw_gpio_{-1};
   uint16_t num_leds_{0};
 
-  std::map<std::string, std::vector<int>> groups_;
-  std::map<std::string, uint16_t> group_caps_;
+  // Group membership is stored as runs of consecutive LED indices in
+  // configured order; a typical contiguous group is a single 4-byte run.
+  struct LedRun {
+    uint16_t start;
+    uint16_t len;
+  };
+  struct StripGroup {
+    std::string name;
+    std::vector<LedRun> runs;
+    uint16_t count{0};
+    uint16_t cap{255};
+    uint16_t lo{0}, hi{0};  // LED extent [lo, hi)
+  };
+  template<typename F> static void for_each_led_(const StripGroup &g, F &&f) {
+    for (const auto &run : g.runs) {
+      for (uint16_t i = 0; i < run.len; i++) f((uint16_t)(run.start + i));
+    }
+  }
+
+  // Half-open LED index range, used to carry dirty regions through the
+  // compose -> scale -> send pipeline.
+  struct LedRange {
+    uint16_t lo{0}, hi{0};
+    bool empty() const { return lo >= hi; }
+    void clear() { lo = hi = 0; }
+    void add(uint16_t l, uint16_t h) {
+      if (l >= h) return;
+      if (empty()) { lo = l; hi = h; return; }
+      if (l < lo) lo = l;
+      if (h > hi) hi = h;
+    }
+    void add(const LedRange &o) { add(o.lo, o.hi); }
+  };
+  std::vector<StripGroup> groups_;  // indexed by group id
+  mutable std::vector<int> legacy_group_;  // get_group() result
+
+  // Group ids backing the arm-select LEDs: away, home, disarm, custom.
+  enum ArmGroupSlot : uint8_t { ARM_SLOT_AWAY = 0, ARM_SLOT_HOME, ARM_SLOT_DISARM, ARM_SLOT_CUSTOM, ARM_SLOT_COUNT };
+  std::array<uint8_t, ARM_SLOT_COUNT> arm_group_ids_{{NO_GROUP, NO_GROUP, NO_GROUP, NO_GROUP}};
 
+  // Frame buffers hold num_leds_ * BPP bytes in wire order (see pixel_format.h).
   std::vector<uint8_t> base_raw_grb_;
+
+  struct StripScene {
+    std::string name;
+    std::vector<uint8_t> grb;  // empty until saved or restored
+    bool restore{false};       // persisted to flash on save
+  };
+  std::vector<StripScene> scenes_;  // indexed by scene id
+  // Preferences are fixed-size, so a scene is stored as a header plus
+  // SCENE_CHUNK_LEDS-sized chunks under consecutive keys.
+  static constexpr uint16_t SCENE_CHUNK_LEDS = 32;
+  struct SceneHeader {
+    uint16_t num_leds;
+    uint8_t bytes_per_pixel;
+  };
+  struct SceneChunk {
+    uint8_t grb[SCENE_CHUNK_LEDS * BPP];
+  };
+
+  // Boot frame: mirrored whenever a write changes the base targets.
+  FrameRestore restore_frame_{FrameRestore::RTC};
+  bool boot_frame_dirty_{false};
+
+  // Fixed-point base transitions. base_raw_grb_ always holds the targets;
+  // LEDs under a fade show fade_from_ mixed toward them. A strip-wide fade
+  // (group NO_GROUP) and per-group fades can run together, applied in start
+  // order, and starting a fade first folds what its LEDs currently show
+  // into fade_from_.
+  struct BaseFade {
+    uint8_t group;
+    uint32_t start_ms;
+    uint32_t duration_ms;
+  };
+  std::vector<BaseFade> fades_;
+  std::vector<uint8_t> fade_from_;
+  std::vector<uint8_t> fade_shown_;  // composed-base scratch for start_fade_() and set_status_group_()
   std::vector<uint8_t> working_grb_;
-  std::vector<uint8_t> last_sent_grb_;
+  std::vector<uint8_t> last_sent_grb_;  // unused in compact mode
+  bool last_sent_valid_{false};         // false until a frame is on the wire, and after a failed transmit
+
+  // Compact mode: no last_sent_grb_ copy. Change detection uses a 32-bit
+  // frame hash and frames are transmitted straight from working_grb_.
+  bool compact_{false};
+  uint32_t last_sent_hash_{0};
+  bool last_sent_hash_valid_{false};
 
   StripMode strip_mode_{StripMode::NORMAL};
   ArmSelectMode arm_select_mode_{ArmSelectMode::NONE};
-  bool arm_select_disable_pending_{false};
+  bool arm_select_disable_pending_{false};  // overlay held until the flash off phase
 
   RfidTransitionState rfid_transition_{RfidTransitionState::INACTIVE};
   uint32_t rfid_transition_start_ms_{0};
   static constexpr uint32_t RFID_FADE_MS = 500;
+  static constexpr uint32_t FADE_Q16_ONE = 65536;
   uint32_t rainbow_start_ms_{0};
   uint32_t rainbow_cycle_ms_{8000};
 
@@ -108,55 +285,250 @@ class ARGBStripComponent : public Component {
   uint32_t action_rainbow_start_ms_{0};
   static constexpr uint32_t ACTION_RAINBOW_CYCLE_MS = 4000;  // 4s cycle
 
-  struct PendingGroup {
-    bool used = false;
-    std::array<bool,3> channel_set{{false,false,false}};
-    std::array<uint8_t,3> values{{0,0,0}};
+  // Compositor layers, bottom to top. BASE holds colours written by outputs
+  // and lights, EFFECTS the per-group effect pixels, STATUS the arm-select
+  // indicator and RFID the programming-mode rainbow, which replaces the
+  // whole strip and fades in and out from black. Each layer keeps its own
+  // dirty range; recomposite_() rebuilds only their union, starting from the
+  // topmost opaque layer that covers it. KEYPAD (keypress feedback) mixes
+  // per LED and never occludes what is below it.
+  enum LayerId : uint8_t { LAYER_BASE = 0, LAYER_EFFECTS, LAYER_STATUS, LAYER_KEYPAD, LAYER_RFID, LAYER_COUNT };
+  enum class BlendMode : uint8_t {
+    REPLACE = 0,  // layer pixels win outright
+    ALPHA         // mixed over the layers below by opacity_q16
   };
-  std::map<std::string, PendingGroup> pending_writes_;
-
-  rmt_channel_handle_t tx_channel_{nullptr};
-  rmt_encoder_handle_t bytes_encoder_{nullptr};
-  rmt_encoder_handle_t copy_encoder_{nullptr};
-  bool rmt_ready_{false};
-  rmt_symbol_word_t reset_symbol_{};
+  struct Layer {
+    BlendMode blend{BlendMode::REPLACE};
+    bool enabled{false};
+    uint32_t opacity_q16{FADE_Q16_ONE};
+    LedRange dirty;
+    bool opaque() const { return blend == BlendMode::REPLACE || opacity_q16 >= FADE_Q16_ONE; }
+  };
+  std::array<Layer, LAYER_COUNT> layers_;
+
+  // STATUS layer content. The arm-select group is held at the base colours
+  // shown when the overlay started; base writes underneath go straight to
+  // base_raw_grb_ and show once the overlay is removed.
+  uint8_t status_group_{NO_GROUP};
+  std::vector<uint8_t> status_pixels_;  // group order, wire layout
+
+  // KEYPAD layer state.
+  KeyFeedbackConfig key_feedback_{NO_GROUP, KeyFeedbackMode::NONE, 0, 0, 0, 0};
+  uint32_t key_feedback_start_ms_{0};
+  uint16_t key_digits_{0};
+
+  // One RMT channel per output, each with its own composite encoder (pixel
+  // bits followed by the reset latch, so a frame is one rmt_transmit()).
+  // Output 0 is pin_ from LED 0; segments follow in LED order. All channels
+  // are started together and awaited together, so a frame takes as long as
+  // the longest output rather than the sum.
+  struct StripOutput {
+    GPIOPin *pin;
+    int raw_gpio;
+    uint16_t start;
+    uint16_t count;
+    rmt_channel_handle_t channel{nullptr};
+    rmt_encoder_handle_t encoder{nullptr};
+    bool dma{false};
+    // SPI backend: the encoded frame and reset latch, in DMA memory.
+    spi_device_handle_t spi{nullptr};
+    uint8_t *spi_buf{nullptr};
+    size_t spi_len{0};
+    spi_transaction_t spi_trans{};
+    bool spi_busy{false};
+  };
+  std::vector<StripOutput> outputs_;
+#if SOC_RMT_SUPPORT_TX_SYNCHRO
+  rmt_sync_manager_handle_t sync_manager_{nullptr};
+#endif
+  OutputBackend backend_{OutputBackend::RMT};
+  bool output_ready_{false};
+  bool use_dma_{false};
+  bool dma_active_{false};
+  bool tx_in_flight_{false};
   rmt_transmit_config_t tx_cfg_{};
 
+  // Effect scheduler. Each effect keeps its last rendered pixels so that
+  // when the per-frame budget runs out the rest are shown unchanged and
+  // rendered first on the next tick.
+  struct ActiveEffect {
+    uint8_t group;
+    std::unique_ptr<StripEffect> effect;
+    uint32_t start_ms;
+    std::vector<uint8_t> pixels;  // group order, wire layout
+    bool rendered{false};
+    bool settled{false};  // finite effect has drawn its final frame
+  };
+  std::vector<ActiveEffect> effects_;
+  uint32_t effect_budget_us_{2000};
+  size_t effect_rr_{0};
+  uint32_t effect_skips_{0};
+
   bool frame_dirty_{false};
-  uint32_t last_anim_eval_{0};
-  static constexpr uint32_t ANIM_TICK_MS = 40;
+  LedRange send_range_;     // LEDs where working_grb_ may differ from last_sent_grb_
+  // Deadline scheduling: active layers report when their output next
+  // changes, and loop() only recomposites at that point. Smooth animations
+  // are limited to frame_interval_ms_.
+  uint32_t frame_interval_ms_{40};
+  uint32_t last_frame_ms_{0};
+  uint32_t next_deadline_ms_{0};
+  bool deadline_armed_{false};
 
   ScalingMode scaling_mode_{ScalingMode::LINEAR};
   float perceptual_gamma_{2.2f};
   bool build_gamma_lut_{true};
   uint8_t gamma_lut_[256]{};
 
+  // Caps and scaling mode folded into output LUTs. Each LED points at the LUT
+  // for the composition of every group it belongs to (LUT_NONE = untouched),
+  // so a frame is scaled in one pass of table lookups.
+  static constexpr uint8_t LUT_NONE = 0xFF;
+  std::vector<std::array<uint8_t, 256>> scaling_luts_;
+  std::vector<uint8_t> led_lut_;
+  bool scaling_luts_dirty_{true};
+
+  // Pre-rendered cycles of the periodic rainbows, one frame per
+  // frame_interval_ms_, built on first use. The RFID table holds final
+  // (scaled) frames and is dropped whenever the scaling LUTs are rebuilt;
+  // the ACTION table holds unscaled status-layer pixels. Tables go to PSRAM,
+  // or to internal RAM when they fit in FRAME_CACHE_RAM_MAX.
+  struct FrameCache {
+    uint8_t *data{nullptr};
+    size_t frame_bytes{0};
+    uint16_t frames{0};
+    uint32_t cycle_ms{0};
+    bool valid{false};
+    bool unavailable{false};  // allocation failed; render live instead
+    bool in_psram{false};
+    const uint8_t *frame_at(uint32_t elapsed) const {
+      uint32_t k = (uint32_t)((uint64_t)(elapsed % cycle_ms) * frames / cycle_ms);
+      return data + k * frame_bytes;
+    }
+  };
+  static constexpr size_t FRAME_CACHE_RAM_MAX = 4096;
+  bool frame_cache_enabled_{false};
+  FrameCache rfid_cache_;
+  FrameCache action_cache_;
+
   void init_rmt_();
-  void mark_dirty_() { frame_dirty_ = true; }
+  void init_spi_();
+  uint32_t scene_pref_key_(uint8_t id) const;
+  void load_scene_(uint8_t id);
+  void store_scene_(uint8_t id);
+  bool store_frame_(uint32_t key, const std::vector<uint8_t> &grb);
+  bool load_frame_(uint32_t key, std::vector<uint8_t> &grb);
+  bool restore_boot_frame_();
+  void save_boot_frame_();
+  void store_boot_frame_flash_();
+  void start_fade_(uint8_t group, uint32_t ms);
+  uint32_t fade_q16_(const BaseFade &f, uint32_t now) const;
+  LedRange fade_range_(const BaseFade &f) const;
+  void compose_base_(uint8_t *dst, const LedRange &r, uint32_t now) const;
+  void log_memory_report_();
+  void schedule_next_frame_(uint32_t now);
+  bool wait_tx_idle_(uint32_t timeout_ms);
+  bool transmit_outputs_(const uint8_t *frame);
+  void mark_dirty_() { mark_layer_dirty_(LAYER_BASE, LedRange{0, num_leds_}); }
+  void mark_layer_dirty_(uint8_t layer, const LedRange &r);
+  void mark_group_dirty_(uint8_t layer, uint8_t group) { mark_layer_dirty_(layer, group_range_(group)); }
+  LedRange group_range_(uint8_t group) const;
+  bool group_covers_(uint8_t group, const LedRange &r) const;
+  bool layer_covers_(uint8_t layer, const LedRange &r) const;
 
   void recomposite_();
-  void build_normal_base_();
-  void build_rainbow_frame_(float fade_factor);
-  void apply_arm_select_overlay_();
-  void apply_group_caps_();
+  void blend_group_(uint8_t group, const uint8_t *src, const LedRange &r, const Layer &layer);
+  void apply_effects_(const LedRange &r);
+  void mark_effects_dirty_();
+  void set_status_group_(uint8_t group);
+  void render_status_layer_();
+  void apply_rfid_layer_(const LedRange &r);
+  void apply_keypad_layer_(const LedRange &r, uint32_t now);
+  uint16_t keypad_level_(uint16_t index, uint16_t count, uint32_t t) const;
+  bool keypad_animating_() const;
+  void apply_group_caps_(uint8_t *grb, const LedRange &r);
+  bool alloc_frame_cache_(FrameCache &cache, size_t frame_bytes, uint32_t cycle_ms);
+  const uint8_t *rfid_cached_frame_(uint32_t elapsed);
+  const uint8_t *action_cached_frame_(uint32_t elapsed);
   void build_gamma_lut_if_needed_();
+  void rebuild_scaling_luts_();
+  void build_group_lut_(uint16_t cap, uint8_t *lut) const;
   void send_frame_();
 
-  int get_arm_select_led_index_() const;
-  std::string get_arm_select_group_name_() const;
+  uint8_t arm_select_group_id_(ArmSelectMode m) const;
+  uint8_t arm_select_group_id_() const { return arm_select_group_id_(arm_select_mode_); }
   bool rfid_visual_active_() const;
-  float current_rfid_fade_factor_() const;
+  uint32_t current_rfid_fade_q16_() const;
   void finish_rfid_fade_out_();
-  void apply_pending_for_group_(const std::string &group);
+  void write_group_base_(uint8_t group, uint8_t channel_mask, const uint8_t *rgb);
+  bool write_group_pixels_(uint8_t *frame, uint8_t group, uint8_t channel_mask, const uint8_t *rgb) const;
   void finalize_arm_select_disable_();
+};
+
+template<typename... Ts> class SetEffectAction : public Action<Ts...> {
+ public:
+  SetEffectAction(ARGBStripComponent *parent, uint8_t group, EffectType type, const EffectParams &params)
+      : parent_(parent), group_(group), type_(type), params_(params) {}
+  void play(Ts... x) override { this->parent_->set_group_effect(this->group_, this->type_, this->params_); }
+
+ protected:
+  ARGBStripComponent *parent_;
+  uint8_t group_;
+  EffectType type_;
+  EffectParams params_;
+};
+
+template<typename... Ts> class ClearEffectAction : public Action<Ts...> {
+ public:
+  ClearEffectAction(ARGBStripComponent *parent, uint8_t group) : parent_(parent), group_(group) {}
+  void play(Ts... x) override { this->parent_->clear_group_effect(this->group_); }
+
+ protected:
+  ARGBStripComponent *parent_;
+  uint8_t group_;
+};
 
-  void hsv_to_grb_(float h, float s, float v, uint8_t &g, uint8_t &r, uint8_t &b) const;
+template<typename... Ts> class SaveSceneAction : public Action<Ts...> {
+ public:
+  SaveSceneAction(ARGBStripComponent *parent, uint8_t scene) : parent_(parent), scene_(scene) {}
+  void play(Ts... x) override { this->parent_->save_scene(this->scene_); }
+
+ protected:
+  ARGBStripComponent *parent_;
+  uint8_t scene_;
+};
+
+template<typename... Ts> class RecallSceneAction : public Action<Ts...> {
+ public:
+  RecallSceneAction(ARGBStripComponent *parent, uint8_t scene, uint32_t transition_ms)
+      : parent_(parent), scene_(scene), transition_ms_(transition_ms) {}
+  void play(Ts... x) override { this->parent_->recall_scene(this->scene_, this->transition_ms_); }
+
+ protected:
+  ARGBStripComponent *parent_;
+  uint8_t scene_;
+  uint32_t transition_ms_;
+};
+
+template<typename... Ts> class SetGroupColorAction : public Action<Ts...> {
+ public:
+  SetGroupColorAction(ARGBStripComponent *parent, uint8_t group, uint8_t r, uint8_t g, uint8_t b,
+                      uint32_t transition_ms)
+      : parent_(parent), group_(group), r_(r), g_(g), b_(b), transition_ms_(transition_ms) {}
+  void play(Ts... x) override {
+    this->parent_->transition_group_rgb(this->group_, this->r_, this->g_, this->b_, this->transition_ms_);
+  }
+
+ protected:
+  ARGBStripComponent *parent_;
+  uint8_t group_;
+  uint8_t r_, g_, b_;
+  uint32_t transition_ms_;
 };
 
 class ARGBStripOutput : public output::FloatOutput, public Component {
  public:
   void set_parent(ARGBStripComponent *p) { parent_ = p; }
-  void set_group_name(const std::string &g) { group_ = g; }
+  void set_group(uint8_t g) { group_ = g; }
   void set_channel(uint8_t ch) { channel_ = ch; }
   void setup() override {}
   void dump_config() override {}
@@ -164,7 +536,7 @@ class ARGBStripOutput : public output::FloatOutput, public Component {
  protected:
   void write_state(float state) override;
   ARGBStripComponent *parent_{nullptr};
-  std::string group_;
+  uint8_t group_{ARGBStripComponent::NO_GROUP};
   uint8_t channel_{0};
 };
 
@@ -0,0 +1,87 @@
+#pragma once
+#include "esphome/core/helpers.h"
+#include "esphome/components/light/light_output.h"
+#include "esphome/components/light/light_state.h"
+#include "esphome/components/light/light_transformer.h"
+#include "argb_strip.h"
+
+#ifdef USE_ESP32
+
+namespace esphome {
+namespace argb_strip {
+
+class ARGBStripLight;
+
+/** Hands a light transition to the strip's fade engine. The strip
+ *  interpolates once per displayed frame, so LightState never writes the
+ *  intermediate colours and the fade does not depend on its loop rate. */
+class ARGBStripTransition : public light::LightTransformer {
+ public:
+  explicit ARGBStripTransition(ARGBStripLight *light) : light_(light) {}
+  void start() override;
+  optional<light::LightColorValues> apply() override { return {}; }
+
+ protected:
+  ARGBStripLight *light_;
+};
+
+/** Exposes one strip group as an RGB (or RGBW) light; the whole colour
+ *  (brightness already applied by LightState) lands in one call. */
+class ARGBStripLight : public light::LightOutput, public Component {
+ public:
+  void set_parent(ARGBStripComponent *p) { parent_ = p; }
+  void set_group(uint8_t g) { group_ = g; }
+  void setup() override {}
+  void dump_config() override {}
+
+  light::LightTraits get_traits() override {
+    auto traits = light::LightTraits();
+    traits.set_supported_color_modes({Pixel::HAS_WHITE ? light::ColorMode::RGB_WHITE : light::ColorMode::RGB});
+    return traits;
+  }
+
+  void setup_state(light::LightState *state) override { state_ = state; }
+  std::unique_ptr<light::LightTransformer> create_default_transition() override {
+    return make_unique<ARGBStripTransition>(this);
+  }
+
+  void write_state(light::LightState *state) override {
+    if (!parent_) return;
+    float r, g, b, w = 0.f;
+    if (Pixel::HAS_WHITE) {
+      state->current_values_as_rgbw(&r, &g, &b, &w);
+    } else {
+      state->current_values_as_rgb(&r, &g, &b);
+    }
+    parent_->set_group_rgbw(group_, to_byte_(r), to_byte_(g), to_byte_(b), to_byte_(w));
+  }
+
+  void start_transition(const light::LightColorValues &target, uint32_t length_ms) {
+    if (!parent_ || !state_) return;
+    float r, g, b, w = 0.f;
+    if (Pixel::HAS_WHITE) {
+      target.as_rgbw(&r, &g, &b, &w, state_->get_gamma_correct());
+    } else {
+      target.as_rgb(&r, &g, &b, state_->get_gamma_correct());
+    }
+    parent_->transition_group_rgbw(group_, to_byte_(r), to_byte_(g), to_byte_(b), to_byte_(w), length_ms);
+  }
+
+ protected:
+  static uint8_t to_byte_(float v) {
+    if (v < 0.f) v = 0.f;
+    if (v > 1.f) v = 1.f;
+    return (uint8_t)(v * 255.0f + 0.5f);
+  }
+
+  ARGBStripComponent *parent_{nullptr};
+  light::LightState *state_{nullptr};
+  uint8_t group_{ARGBStripComponent::NO_GROUP};
+};
+
+inline void ARGBStripTransition::start() { light_->start_transition(this->target_values_, this->length_); }
+
+}  // namespace argb_strip
+}  // namespace esphome
+
+#endif  // USE_ESP32
@@ -0,0 +1,99 @@
+#include "effects.h"
+
+namespace esphome {
+namespace argb_strip {
+
+void StripEffect::put_(uint8_t *grb, uint16_t i, uint16_t level) const {
+  Pixel::set_rgb(grb + i * BPP, (uint8_t)(((uint32_t) params_.r * level) >> 8),
+                 (uint8_t)(((uint32_t) params_.g * level) >> 8), (uint8_t)(((uint32_t) params_.b * level) >> 8));
+}
+
+// Whole group fades in and out with a squared triangle for a softer floor.
+class BreatheEffect : public StripEffect {
+ public:
+  using StripEffect::StripEffect;
+  void render(uint8_t *grb, uint16_t count, uint32_t t) override {
+    uint32_t period = params_.period_ms ? params_.period_ms : 1;
+    uint32_t phase = t % period;
+    uint32_t half = period / 2 ? period / 2 : 1;
+    uint32_t tri = phase < half ? phase * 256 / half : (period - phase) * 256 / (period - half);
+    if (tri > 256) tri = 256;
+    uint16_t level = (uint16_t)((tri * tri) >> 8);
+    for (uint16_t i = 0; i < count; i++) put_(grb, i, level);
+  }
+};
+
+// A block of `size` lit LEDs travels around the group once per period.
+class ChaseEffect : public StripEffect {
+ public:
+  using StripEffect::StripEffect;
+  void render(uint8_t *grb, uint16_t count, uint32_t t) override {
+    if (count == 0) return;
+    uint32_t period = params_.period_ms ? params_.period_ms : 1;
+    uint16_t head = (uint16_t)((uint64_t)(t % period) * count / period);
+    for (uint16_t i = 0; i < count; i++) {
+      uint16_t pos = params_.reverse ? (uint16_t)(count - 1 - i) : i;
+      uint16_t d = (uint16_t)((pos + count - head) % count);
+      put_(grb, i, d < params_.size ? 256 : 0);
+    }
+  }
+};
+
+// Bright head with a linearly decaying tail of `size` LEDs.
+class CometEffect : public StripEffect {
+ public:
+  using StripEffect::StripEffect;
+  void render(uint8_t *grb, uint16_t count, uint32_t t) override {
+    if (count == 0) return;
+    uint32_t period = params_.period_ms ? params_.period_ms : 1;
+    uint16_t tail = params_.size ? params_.size : 1;
+    uint16_t head = (uint16_t)((uint64_t)(t % period) * count / period);
+    for (uint16_t i = 0; i < count; i++) {
+      uint16_t pos = params_.reverse ? (uint16_t)(count - 1 - i) : i;
+      uint16_t d = (uint16_t)((head + count - pos) % count);
+      put_(grb, i, d < tail ? (uint16_t)(256 * (tail - d) / tail) : 0);
+    }
+  }
+};
+
+// Bar that fills (or drains when reversed) over period_ms, e.g. exit delay.
+class ProgressEffect : public StripEffect {
+ public:
+  using StripEffect::StripEffect;
+  void render(uint8_t *grb, uint16_t count, uint32_t t) override {
+    uint32_t period = params_.period_ms ? params_.period_ms : 1;
+    uint32_t el = t < period ? t : period;
+    if (params_.reverse) el = period - el;
+    // Fill level in 1/256 LED units so the leading LED fades in smoothly.
+    uint32_t fill = (uint32_t)((uint64_t) el * count * 256 / period);
+    for (uint16_t i = 0; i < count; i++) {
+      uint32_t lit = (uint32_t) i * 256;
+      uint16_t level = fill >= lit + 256 ? 256 : (fill > lit ? (uint16_t)(fill - lit) : 0);
+      put_(grb, i, level);
+    }
+  }
+  bool finished(uint32_t t) const override { return t >= params_.period_ms; }
+};
+
+std::unique_ptr<StripEffect> make_effect(EffectType type, const EffectParams &params) {
+  switch (type) {
+    case EffectType::BREATHE: return std::unique_ptr<StripEffect>(new BreatheEffect(params));
+    case EffectType::CHASE: return std::unique_ptr<StripEffect>(new ChaseEffect(params));
+    case EffectType::COMET: return std::unique_ptr<StripEffect>(new CometEffect(params));
+    case EffectType::PROGRESS: return std::unique_ptr<StripEffect>(new ProgressEffect(params));
+  }
+  return nullptr;
+}
+
+const char *effect_type_name(EffectType type) {
+  switch (type) {
+    case EffectType::BREATHE: return "breathe";
+    case EffectType::CHASE: return "chase";
+    case EffectType::COMET: return "comet";
+    case EffectType::PROGRESS: return "progress";
+  }
+  return "unknown";
+}
+
+}  // namespace argb_strip
+}  // namespace esphome
@@ -0,0 +1,45 @@
+#pragma once
+#include "pixel_format.h"
+#include <cstdint>
+#include <memory>
+
+namespace esphome {
+namespace argb_strip {
+
+// Built-in effects; ids must match EFFECT_TYPES in __init__.py.
+enum class EffectType : uint8_t {
+  BREATHE = 0,
+  CHASE,
+  COMET,
+  PROGRESS
+};
+
+struct EffectParams {
+  uint8_t r{255}, g{255}, b{255};
+  uint32_t period_ms{2000};  // cycle length, or total duration for PROGRESS
+  uint16_t size{3};          // chase width / comet tail length in LEDs
+  bool reverse{false};       // run backwards; PROGRESS drains instead of fills
+};
+
+/** An effect renders a group's pixels (in group LED order) for time t. */
+class StripEffect {
+ public:
+  explicit StripEffect(const EffectParams &p) : params_(p) {}
+  virtual ~StripEffect() = default;
+
+  // grb holds count pixels of BPP bytes in wire order; t is ms since the
+  // effect started.
+  virtual void render(uint8_t *grb, uint16_t count, uint32_t t) = 0;
+  // Finite effects report true once their output no longer changes.
+  virtual bool finished(uint32_t t) const { return false; }
+
+ protected:
+  void put_(uint8_t *grb, uint16_t i, uint16_t level) const;  // level 0..256
+  EffectParams params_;
+};
+
+std::unique_ptr<StripEffect> make_effect(EffectType type, const EffectParams &params);
+const char *effect_type_name(EffectType type);
+
+}  // namespace argb_strip
+}  // namespace esphome
@@ -0,0 +1,58 @@
+#pragma once
+#include <cstdint>
+
+namespace esphome {
+namespace argb_strip {
+
+// Integer hue pipeline for the rainbow animations. tests/hue_wheel_test.cpp
+// compares it against the float HSV path it replaced.
+
+// Fixed-point hue wheel: 6 sectors of 256 steps. The ramp table holds the
+// rising edge of a sector; the falling edge is its complement.
+static constexpr uint32_t HUE_STEPS = 1536;
+static constexpr uint32_t HUE_FP_WHEEL = HUE_STEPS << 8;  // 8 fractional bits per step
+
+struct HueRamp {
+  uint8_t v[256];
+  constexpr HueRamp() : v() {
+    for (int i = 0; i < 256; i++) v[i] = (uint8_t)((i * 255 + 128) >> 8);
+  }
+};
+static constexpr HueRamp HUE_RAMP{};
+
+// Full saturation / full value hue -> GRB.
+inline void hue_to_grb(uint16_t hue, uint8_t &g, uint8_t &r, uint8_t &b) {
+  uint8_t up = HUE_RAMP.v[hue & 0xFF];
+  uint8_t down = 255 - up;
+  switch (hue >> 8) {
+    case 0: r = 255; g = up; b = 0; break;
+    case 1: r = down; g = 255; b = 0; break;
+    case 2: r = 0; g = 255; b = up; break;
+    case 3: r = 0; g = down; b = 255; break;
+    case 4: r = up; g = 0; b = 255; break;
+    default: r = 255; g = 0; b = down; break;
+  }
+}
+
+// Walks n evenly spaced hues around the wheel starting at base_fp, without
+// per-LED divides (remainder is carried Bresenham-style).
+struct HueSweep {
+  uint32_t pos, step, frac, count, acc{0};
+  HueSweep(uint32_t base_fp, uint32_t n) : pos(base_fp), step(HUE_FP_WHEEL / n), frac(HUE_FP_WHEEL % n), count(n) {}
+  uint16_t next() {
+    uint32_t h = (pos + 128) >> 8;
+    if (h >= HUE_STEPS) h -= HUE_STEPS;
+    pos += step;
+    acc += frac;
+    if (acc >= count) { acc -= count; pos++; }
+    if (pos >= HUE_FP_WHEEL) pos -= HUE_FP_WHEEL;
+    return (uint16_t) h;
+  }
+};
+
+inline uint32_t hue_phase_fp(uint32_t elapsed, uint32_t cycle) {
+  return (uint32_t)((uint64_t)(elapsed % cycle) * HUE_FP_WHEEL / cycle);
+}
+
+}  // namespace argb_strip
+}  // namespace esphome
@@ -0,0 +1,37 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import light
+from esphome.const import CONF_OUTPUT_ID
+
+from . import (
+    argb_strip_ns,
+    ARGBStripComponent,
+    CONF_ARGB_STRIP_ID,
+    CONF_GROUP,
+    find_strip_config,
+    group_index,
+    validate_group_reference,
+)
+
+ARGBStripLight = argb_strip_ns.class_("ARGBStripLight", light.LightOutput, cg.Component)
+
+CONFIG_SCHEMA = light.RGB_LIGHT_SCHEMA.extend(
+    {
+        cv.GenerateID(CONF_OUTPUT_ID): cv.declare_id(ARGBStripLight),
+        cv.GenerateID(CONF_ARGB_STRIP_ID): cv.use_id(ARGBStripComponent),
+        cv.Required(CONF_GROUP): cv.valid_name,
+    }
+).extend(cv.COMPONENT_SCHEMA)
+
+FINAL_VALIDATE_SCHEMA = validate_group_reference
+
+
+async def to_code(config):
+    parent = await cg.get_variable(config[CONF_ARGB_STRIP_ID])
+    var = cg.new_Pvariable(config[CONF_OUTPUT_ID])
+    await cg.register_component(var, config)
+    await light.register_light(var, config)
+
+    cg.add(var.set_parent(parent))
+    strip_config = find_strip_config(config[CONF_ARGB_STRIP_ID])
+    cg.add(var.set_group(group_index(strip_config, config[CONF_GROUP])))
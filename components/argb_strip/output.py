@@ -1,18 +1,27 @@
 import esphome.codegen as cg
 import esphome.config_validation as cv
+import esphome.final_validate as fv
 from esphome.components import output
 from esphome.const import CONF_ID
 
-from . import argb_strip_ns, ARGBStripComponent
+from . import (
+    argb_strip_ns,
+    ARGBStripComponent,
+    CONF_ARGB_STRIP_ID,
+    CONF_GROUP,
+    find_strip_config,
+    group_index,
+    has_white_channel,
+    validate_group_reference,
+)
 
-CONF_ARGB_STRIP_ID = "argb_strip_id"
-CONF_GROUP = "group"
 CONF_CHANNEL = "channel"
 
 COLOR_CHANNELS = {
     "red": 0,
     "green": 1,
     "blue": 2,
+    "white": 3,  # RGBW pixel formats only
 }
 
 ARGBStripOutput = argb_strip_ns.class_("ARGBStripOutput", output.FloatOutput, cg.Component)
@@ -26,6 +35,18 @@ CONFIG_SCHEMA = output.FLOAT_OUTPUT_SCHEMA.extend(
     }
 ).extend(cv.COMPONENT_SCHEMA)
 
+def _final_validate(config):
+    validate_group_reference(config)
+    if config[CONF_CHANNEL] == "white":
+        full_config = fv.full_config.get()
+        path = full_config.get_path_for_id(config[CONF_ARGB_STRIP_ID])[:-1]
+        if not has_white_channel(full_config.get_config_for_path(path)):
+            raise cv.Invalid("Channel 'white' needs an RGBW pixel_format on the argb_strip")
+    return config
+
+
+FINAL_VALIDATE_SCHEMA = _final_validate
+
 async def to_code(config):
     parent = await cg.get_variable(config[CONF_ARGB_STRIP_ID])
     var = cg.new_Pvariable(config[CONF_ID])
@@ -33,5 +54,6 @@ async def to_code(config):
     await cg.register_component(var, config)
 
     cg.add(var.set_parent(parent))
-    cg.add(var.set_group_name(config[CONF_GROUP]))
+    strip_config = find_strip_config(config[CONF_ARGB_STRIP_ID])
+    cg.add(var.set_group(group_index(strip_config, config[CONF_GROUP])))
     cg.add(var.set_channel(config[CONF_CHANNEL]))
@@ -0,0 +1,77 @@
+#pragma once
+#include "esphome/core/defines.h"
+#include <cstdint>
+
+namespace esphome {
+namespace argb_strip {
+
+// Pixel layout on the wire. Every frame buffer is kept in wire order, so
+// channel offsets and bytes per pixel are compile-time constants in the
+// hot loops. Logical channels are 0=r, 1=g, 2=b, 3=w.
+template<uint8_t R, uint8_t G, uint8_t B, uint8_t W, uint8_t N> struct PixelLayout {
+  static constexpr uint8_t R_OFF = R;
+  static constexpr uint8_t G_OFF = G;
+  static constexpr uint8_t B_OFF = B;
+  static constexpr uint8_t W_OFF = W;  // only meaningful when HAS_WHITE
+  static constexpr uint8_t BYTES = N;
+  static constexpr uint8_t CHANNELS = N;
+  static constexpr bool HAS_WHITE = N == 4;
+
+  static constexpr uint8_t offset(uint8_t channel) {
+    return channel == 0 ? R : channel == 1 ? G : channel == 2 ? B : W;
+  }
+  // Colour without a white component; clears white on RGBW strips.
+  static inline void set_rgb(uint8_t *px, uint8_t r, uint8_t g, uint8_t b) {
+    px[R] = r;
+    px[G] = g;
+    px[B] = b;
+    if (HAS_WHITE) px[W] = 0;
+  }
+};
+using PixelGRB = PixelLayout<1, 0, 2, 3, 3>;
+using PixelRGB = PixelLayout<0, 1, 2, 3, 3>;
+using PixelGRBW = PixelLayout<1, 0, 2, 3, 4>;
+using PixelRGBW = PixelLayout<0, 1, 2, 3, 4>;
+
+// Bit timings in 25 ns RMT ticks (40 MHz), plus the reset latch.
+template<uint16_t T0H_, uint16_t T0L_, uint16_t T1H_, uint16_t T1L_, uint16_t RESET_> struct ChipTiming {
+  static constexpr uint16_t T0H = T0H_;
+  static constexpr uint16_t T0L = T0L_;
+  static constexpr uint16_t T1H = T1H_;
+  static constexpr uint16_t T1L = T1L_;
+  static constexpr uint16_t RESET_TICKS = RESET_;
+};
+using TimingWS2812 = ChipTiming<16, 34, 32, 18, 2000>;   // 0.4/0.85, 0.8/0.45 us, 50 us reset
+using TimingSK6812 = ChipTiming<12, 36, 24, 24, 3200>;   // 0.3/0.9, 0.6/0.6 us, 80 us reset
+using TimingWS2811 = ChipTiming<20, 80, 48, 52, 11200>;  // 400 kHz: 0.5/2.0, 1.2/1.3 us, 280 us reset
+
+// Selected per build by pixel_format / chipset in __init__.py.
+#if defined(USE_ARGB_STRIP_PIXEL_RGBW)
+using Pixel = PixelRGBW;
+static const char *const PIXEL_FORMAT_NAME = "RGBW";
+#elif defined(USE_ARGB_STRIP_PIXEL_GRBW)
+using Pixel = PixelGRBW;
+static const char *const PIXEL_FORMAT_NAME = "GRBW";
+#elif defined(USE_ARGB_STRIP_PIXEL_RGB)
+using Pixel = PixelRGB;
+static const char *const PIXEL_FORMAT_NAME = "RGB";
+#else
+using Pixel = PixelGRB;
+static const char *const PIXEL_FORMAT_NAME = "GRB";
+#endif
+
+#if defined(USE_ARGB_STRIP_CHIPSET_SK6812)
+using Timing = TimingSK6812;
+static const char *const CHIPSET_NAME = "SK6812";
+#elif defined(USE_ARGB_STRIP_CHIPSET_WS2811)
+using Timing = TimingWS2811;
+static const char *const CHIPSET_NAME = "WS2811";
+#else
+using Timing = TimingWS2812;
+static const char *const CHIPSET_NAME = "WS2812";
+#endif
+
+static constexpr uint8_t BPP = Pixel::BYTES;
+
+}  // namespace argb_strip
+}  // namespace esphome
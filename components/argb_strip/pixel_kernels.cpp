@@ -0,0 +1,64 @@
+#include "pixel_kernels.h"
+#include <cstring>
+
+namespace esphome {
+namespace argb_strip {
+namespace kernels {
+
+void blend(uint8_t *dst, const uint8_t *src, size_t len, uint32_t a) {
+  uint32_t ia = 65536 - a;
+  for (size_t i = 0; i < len; i++) dst[i] = (uint8_t)((src[i] * a + dst[i] * ia + 32768) >> 16);
+}
+
+// Reference kernels
+
+void lut_apply_ref(uint8_t *px, size_t len, const uint8_t *lut) {
+  for (size_t i = 0; i < len; i++) px[i] = lut[px[i]];
+}
+
+bool equal_ref(const uint8_t *a, const uint8_t *b, size_t len) {
+  for (size_t i = 0; i < len; i++) {
+    if (a[i] != b[i]) return false;
+  }
+  return true;
+}
+
+// Word kernels. Loads and stores go through memcpy so unaligned buffers
+// are fine; the compiler turns them into plain 32-bit accesses.
+
+static inline uint32_t load32(const uint8_t *p) {
+  uint32_t v;
+  memcpy(&v, p, 4);
+  return v;
+}
+static inline void store32(uint8_t *p, uint32_t v) { memcpy(p, &v, 4); }
+
+// The lookups stay per byte, but the frame is read and written a word at a
+// time, which quarters the accesses to frame memory (often PSRAM).
+void lut_apply_word(uint8_t *px, size_t len, const uint8_t *lut) {
+  size_t i = 0;
+  for (; i + 4 <= len; i += 4) {
+    uint32_t v = load32(px + i);
+    v = (uint32_t) lut[v & 0xFF] | (uint32_t) lut[(v >> 8) & 0xFF] << 8 | (uint32_t) lut[(v >> 16) & 0xFF] << 16 |
+        (uint32_t) lut[v >> 24] << 24;
+    store32(px + i, v);
+  }
+  lut_apply_ref(px + i, len - i, lut);
+}
+
+bool equal_word(const uint8_t *a, const uint8_t *b, size_t len) {
+  size_t i = 0;
+  for (; i + 16 <= len; i += 16) {
+    uint32_t x = (load32(a + i) ^ load32(b + i)) | (load32(a + i + 4) ^ load32(b + i + 4)) |
+                 (load32(a + i + 8) ^ load32(b + i + 8)) | (load32(a + i + 12) ^ load32(b + i + 12));
+    if (x) return false;
+  }
+  for (; i + 4 <= len; i += 4) {
+    if (load32(a + i) != load32(b + i)) return false;
+  }
+  return equal_ref(a + i, b + i, len - i);
+}
+
+}  // namespace kernels
+}  // namespace argb_strip
+}  // namespace esphome
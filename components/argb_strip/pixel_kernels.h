@@ -0,0 +1,38 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace esphome {
+namespace argb_strip {
+namespace kernels {
+
+// Byte-parallel frame kernels. The reference versions define the results;
+// the word versions move four subpixels per 32-bit load and store and must
+// match them bit for bit (tests/pixel_kernels_test.cpp checks this on the
+// host). Define ARGB_STRIP_SCALAR_KERNELS to build with the reference
+// versions.
+
+// dst = (src * a + dst * (65536 - a) + 32768) >> 16 per byte, a in Q16
+// (0..65536). A Q16 product needs 25 bits per subpixel, so four of them do
+// not fit in a word and blend only has the scalar form.
+void blend(uint8_t *dst, const uint8_t *src, size_t len, uint32_t a);
+// px[i] = lut[px[i]].
+void lut_apply_ref(uint8_t *px, size_t len, const uint8_t *lut);
+void lut_apply_word(uint8_t *px, size_t len, const uint8_t *lut);
+// true when the two buffers hold the same bytes.
+bool equal_ref(const uint8_t *a, const uint8_t *b, size_t len);
+bool equal_word(const uint8_t *a, const uint8_t *b, size_t len);
+
+#ifdef ARGB_STRIP_SCALAR_KERNELS
+inline void lut_apply(uint8_t *px, size_t len, const uint8_t *lut) { lut_apply_ref(px, len, lut); }
+inline bool equal(const uint8_t *a, const uint8_t *b, size_t len) { return equal_ref(a, b, len); }
+static const char *const KERNEL_NAME = "scalar";
+#else
+inline void lut_apply(uint8_t *px, size_t len, const uint8_t *lut) { lut_apply_word(px, len, lut); }
+inline bool equal(const uint8_t *a, const uint8_t *b, size_t len) { return equal_word(a, b, len); }
+static const char *const KERNEL_NAME = "32-bit word";
+#endif
+
+}  // namespace kernels
+}  // namespace argb_strip
+}  // namespace esphome
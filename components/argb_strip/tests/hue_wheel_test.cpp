@@ -0,0 +1,105 @@
+// Host comparison of the fixed-point hue wheel against the float HSV
+// rainbow it replaced, plus a rough timing of both. Not part of the
+// firmware build:
+//
+//   g++ -std=gnu++17 -O2 hue_wheel_test.cpp -o hue_wheel_test
+//   ./hue_wheel_test
+//
+// Exits non-zero if any channel differs by more than one count.
+#include "../hue_wheel.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace esphome::argb_strip;
+
+// The float kernel as it was: fmodf hue per LED, float HSV at full
+// saturation and value, then the fade factor rounded per channel.
+static void hsv_to_grb_float(float h, uint8_t &g, uint8_t &r, uint8_t &b) {
+  h = fmodf(h, 1.0f) * 6.0f;
+  int i = (int) floorf(h);
+  float f = h - i;
+  float q = 1.0f - f, t = f;
+  float rf, gf, bf;
+  switch (i) {
+    case 0: rf = 1; gf = t; bf = 0; break;
+    case 1: rf = q; gf = 1; bf = 0; break;
+    case 2: rf = 0; gf = 1; bf = t; break;
+    case 3: rf = 0; gf = q; bf = 1; break;
+    case 4: rf = t; gf = 0; bf = 1; break;
+    default: rf = 1; gf = 0; bf = q; break;
+  }
+  r = (uint8_t)(rf * 255.0f + 0.5f);
+  g = (uint8_t)(gf * 255.0f + 0.5f);
+  b = (uint8_t)(bf * 255.0f + 0.5f);
+}
+
+static void rainbow_float(uint8_t *grb, uint16_t n, uint32_t elapsed, uint32_t cycle, float fade) {
+  float base_h = fmodf((float) elapsed / (float) cycle, 1.0f);
+  for (uint16_t i = 0; i < n; i++, grb += 3) {
+    float h = fmodf(base_h + (float) i / (float) n, 1.0f);
+    hsv_to_grb_float(h, grb[0], grb[1], grb[2]);
+    if (fade < 0.999f) {
+      for (int c = 0; c < 3; c++) grb[c] = (uint8_t)(grb[c] * fade + 0.5f);
+    }
+  }
+}
+
+// The fixed-point kernel; the fade is the Q16 blend from black that the
+// RFID layer applies.
+static void rainbow_fixed(uint8_t *grb, uint16_t n, uint32_t elapsed, uint32_t cycle, uint32_t fade_q16) {
+  HueSweep sweep(hue_phase_fp(elapsed, cycle), n);
+  for (uint16_t i = 0; i < n; i++, grb += 3) {
+    hue_to_grb(sweep.next(), grb[0], grb[1], grb[2]);
+    if (fade_q16 < 65536) {
+      for (int c = 0; c < 3; c++) grb[c] = (uint8_t)((grb[c] * fade_q16 + 32768) >> 16);
+    }
+  }
+}
+
+int main() {
+  std::mt19937 rng(0x48554521);
+  std::vector<uint8_t> a(600 * 3), b(600 * 3);
+  int worst = 0;
+  uint64_t samples = 0;
+  for (uint16_t n = 1; n < 600; n++) {
+    for (int iter = 0; iter < 200; iter++) {
+      uint32_t cycle = 500 + rng() % 59501;
+      uint32_t elapsed = rng() % (cycle * 4);
+      uint32_t fade_q16 = (iter & 1) ? 65536 : rng() % 65537;
+      rainbow_float(a.data(), n, elapsed, cycle, (float) fade_q16 / 65536.0f);
+      rainbow_fixed(b.data(), n, elapsed, cycle, fade_q16);
+      for (size_t k = 0; k < (size_t) n * 3; k++) {
+        int d = std::abs((int) a[k] - (int) b[k]);
+        if (d > worst) worst = d;
+        if (d > 1) {
+          printf("n=%u cycle=%u elapsed=%u fade=%u led=%zu: float %u fixed %u\n", n, cycle, elapsed, fade_q16, k / 3,
+                 a[k], b[k]);
+          return 1;
+        }
+      }
+      samples += n * 3;
+    }
+  }
+  printf("%llu samples, worst difference %d\n", (unsigned long long) samples, worst);
+
+  const uint16_t n = 300;
+  const int reps = 20000;
+  volatile uint8_t sink = 0;
+  auto time_us = [&](auto f) {
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < reps; i++) {
+      f((uint32_t) i * 40);
+      sink = sink + a[i % a.size()] + b[i % b.size()];
+    }
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count() / reps;
+  };
+  double tf = time_us([&](uint32_t t) { rainbow_float(a.data(), n, t, 5000, 0.5f); });
+  double tx = time_us([&](uint32_t t) { rainbow_fixed(b.data(), n, t, 5000, 32768); });
+  printf("%u LEDs, faded: float %.2f us/frame, fixed %.2f us/frame\n", n, tf, tx);
+  return 0;
+}
@@ -0,0 +1,92 @@
+// Host check that the word kernels match the reference kernels bit for
+// bit, plus a rough timing of both. Not part of the firmware build:
+//
+//   g++ -std=gnu++17 -O2 pixel_kernels_test.cpp ../pixel_kernels.cpp -o pixel_kernels_test
+//   ./pixel_kernels_test
+//
+// Exits non-zero on the first mismatch.
+#include "../pixel_kernels.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace esphome::argb_strip::kernels;
+
+static std::mt19937 rng(0x41524742);
+
+static void fill(uint8_t *p, size_t n) {
+  for (size_t i = 0; i < n; i++) p[i] = (uint8_t) rng();
+}
+
+// Random lengths up to a 600-LED RGBW frame at every start alignment, so
+// the word loops and their byte tails are both covered.
+static bool check_lut_apply() {
+  uint8_t lut[256];
+  std::vector<uint8_t> a(2404), b(2404);
+  for (int iter = 0; iter < 20000; iter++) {
+    fill(lut, sizeof(lut));
+    size_t off = rng() % 4, len = rng() % (a.size() - off);
+    fill(a.data(), a.size());
+    b = a;
+    lut_apply_ref(a.data() + off, len, lut);
+    lut_apply_word(b.data() + off, len, lut);
+    if (a != b) {
+      printf("lut_apply mismatch: off=%zu len=%zu\n", off, len);
+      return false;
+    }
+  }
+  return true;
+}
+
+static bool check_equal() {
+  std::vector<uint8_t> a(2404), b(2404);
+  for (int iter = 0; iter < 20000; iter++) {
+    size_t off_a = rng() % 4, off_b = rng() % 4;
+    size_t len = rng() % (a.size() - 4);
+    fill(a.data(), a.size());
+    memcpy(b.data() + off_b, a.data() + off_a, len);
+    // Half the cases differ in one byte anywhere in the range.
+    if (len && (rng() & 1)) b[off_b + rng() % len] ^= (uint8_t)(1 + rng() % 255);
+    bool ref = equal_ref(a.data() + off_a, b.data() + off_b, len);
+    bool word = equal_word(a.data() + off_a, b.data() + off_b, len);
+    if (ref != word) {
+      printf("equal mismatch: off=%zu/%zu len=%zu ref=%d word=%d\n", off_a, off_b, len, ref, word);
+      return false;
+    }
+  }
+  return true;
+}
+
+template<typename F> static double time_us(F f, int reps) {
+  auto t0 = std::chrono::steady_clock::now();
+  for (int i = 0; i < reps; i++) f();
+  return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count() / reps;
+}
+
+static void bench() {
+  // 300 RGB LEDs, the size of a typical keypad strip plus a room run.
+  const size_t len = 900;
+  const int reps = 20000;
+  uint8_t lut[256];
+  fill(lut, sizeof(lut));
+  std::vector<uint8_t> a(len), b(len);
+  fill(a.data(), len);
+  b = a;
+  volatile bool sink;
+  printf("lut_apply  ref %6.3f us  word %6.3f us\n", time_us([&] { lut_apply_ref(a.data(), len, lut); }, reps),
+         time_us([&] { lut_apply_word(a.data(), len, lut); }, reps));
+  b = a;
+  printf("equal      ref %6.3f us  word %6.3f us\n", time_us([&] { sink = equal_ref(a.data(), b.data(), len); }, reps),
+         time_us([&] { sink = equal_word(a.data(), b.data(), len); }, reps));
+  (void) sink;
+}
+
+int main() {
+  if (!check_lut_apply() || !check_equal()) return 1;
+  printf("word kernels match the reference kernels\n");
+  bench();
+  return 0;
+}
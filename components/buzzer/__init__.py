@@ -1,10 +1,17 @@
 import esphome.codegen as cg
 import esphome.config_validation as cv
-from esphome.const import CONF_ID, CONF_PIN
+from esphome.const import CONF_ID, CONF_PIN, CONF_OUTPUT, CONF_MIN_FREQUENCY, CONF_MAX_FREQUENCY
+from esphome.components import output
+from esphome.components.esp32 import get_esp32_variant
 from esphome import automation, pins
+import esphome.final_validate as fv
+
+AUTO_LOAD = ["output"]
 
 buzzer_ns = cg.esphome_ns.namespace("buzzer")
 BuzzerComponent = buzzer_ns.class_("BuzzerComponent", cg.Component)
+BuzzerOutputMode = buzzer_ns.enum("BuzzerOutputMode", is_class=True)
+BuzzerSource = buzzer_ns.enum("BuzzerSource", is_class=True)
 
 StartAction = buzzer_ns.class_("StartAction", automation.Action)
 StopAction = buzzer_ns.class_("StopAction", automation.Action)
@@ -22,21 +29,166 @@ CONF_LONG_PAUSE = "long_pause"
 CONF_TONE = "tone"
 CONF_REPEAT = "repeat"
 CONF_BEEP_LENGTH = "beep_length"
+CONF_TONES = "tones"
+CONF_OUTPUT_MODE = "output_mode"
+CONF_LEDC_TIMER = "ledc_timer"
+CONF_LEDC_CHANNEL = "ledc_channel"
+CONF_KEY_BEEP_TONE = "key_beep_tone"
+CONF_CHANNEL = "channel"
+CONF_PLATFORM = "platform"
+CONF_SOURCE = "source"
+CONF_PRIORITY = "priority"
+
+OUTPUT_MODES = {
+    "gpio": BuzzerOutputMode.GPIO,
+    "ledc": BuzzerOutputMode.LEDC,
+}
+
+# Pattern sources; a higher-priority source pre-empts a lower one, which
+# resumes once it finishes or is stopped.
+SOURCES = {
+    "default": BuzzerSource.DEFAULT,
+    "alarm": BuzzerSource.ALARM,
+    "fault": BuzzerSource.FAULT,
+    "entry_delay": BuzzerSource.ENTRY_DELAY,
+    "exit_delay": BuzzerSource.EXIT_DELAY,
+    "chime": BuzzerSource.CHIME,
+}
+SOURCE_ALL = "all"
 
 MULTI_CONF = True
 
-CONFIG_SCHEMA = cv.Schema(
-    {
-        cv.Required(CONF_ID): cv.declare_id(BuzzerComponent),
-        cv.Required(CONF_PIN): pins.gpio_output_pin_schema,
-    }
-).extend(cv.COMPONENT_SCHEMA)
+
+def _validate_frequency_range(config):
+    if config[CONF_MIN_FREQUENCY] >= config[CONF_MAX_FREQUENCY]:
+        raise cv.Invalid(f"{CONF_MIN_FREQUENCY} must be below {CONF_MAX_FREQUENCY}")
+    return config
+
+
+# Variants with 6 LEDC channels; the rest have 8. All have 4 timers.
+_SIX_LEDC_CHANNEL_VARIANTS = {"ESP32C2", "ESP32C3", "ESP32C6", "ESP32H2"}
+LEDC_TIMERS = 4
+
+
+def _ledc_channel_count():
+    return 6 if get_esp32_variant() in _SIX_LEDC_CHANNEL_VARIANTS else 8
+
+
+def _validate_ledc(config):
+    # Default to the last channel and timer; the ledc output platform hands
+    # channels out from 0 upwards.
+    if config[CONF_OUTPUT_MODE] != "ledc":
+        return config
+    channels = _ledc_channel_count()
+    config.setdefault(CONF_LEDC_CHANNEL, channels - 1)
+    config.setdefault(CONF_LEDC_TIMER, LEDC_TIMERS - 1)
+    if config[CONF_LEDC_CHANNEL] >= channels:
+        raise cv.Invalid(
+            f"{get_esp32_variant()} has LEDC channels 0-{channels - 1}",
+            path=[CONF_LEDC_CHANNEL],
+        )
+    return config
+
+
+# Only the classic ESP32 has high-speed LEDC channels.
+_HIGH_SPEED_LEDC_VARIANTS = {"ESP32"}
+
+
+def _ledc_output_low_speed(channel):
+    """Low-speed (channel, timer) used by ledc output channel `channel`, or
+    None when it runs in high-speed mode. On the classic ESP32 the ledc
+    platform puts channels 0-7 in high-speed mode and 8-15 on low-speed
+    channel n - 8; elsewhere every channel is low-speed."""
+    if get_esp32_variant() in _HIGH_SPEED_LEDC_VARIANTS:
+        if channel < 8:
+            return None
+        channel -= 8
+    return channel, channel // 2
+
+
+def _final_validate_ledc(config):
+    # The buzzer always drives a low-speed channel and timer. Each ledc
+    # output takes the next channel in declaration order unless it sets
+    # one; other ledc-mode buzzers claim theirs directly.
+    if config[CONF_OUTPUT_MODE] != "ledc":
+        return config
+    full = fv.full_config.get()
+    users = []
+    ledc_outputs = [o for o in full.get("output", []) if o.get(CONF_PLATFORM) == "ledc"]
+    for index, out in enumerate(ledc_outputs):
+        channel = out.get(CONF_CHANNEL, index)
+        slot = _ledc_output_low_speed(channel)
+        if slot is not None:
+            users.append((f"output '{out[CONF_ID]}' (channel {channel})", *slot))
+    for other in full.get("buzzer", []):
+        if other[CONF_ID] == config[CONF_ID] or other.get(CONF_OUTPUT_MODE) != "ledc":
+            continue
+        users.append((f"buzzer '{other[CONF_ID]}'", other[CONF_LEDC_CHANNEL], other[CONF_LEDC_TIMER]))
+    for user, channel, timer in users:
+        if channel == config[CONF_LEDC_CHANNEL]:
+            raise cv.Invalid(
+                f"LEDC low-speed channel {channel} is also used by {user}",
+                path=[CONF_LEDC_CHANNEL],
+            )
+        if timer == config[CONF_LEDC_TIMER]:
+            raise cv.Invalid(
+                f"LEDC low-speed timer {timer} is also used by {user}",
+                path=[CONF_LEDC_TIMER],
+            )
+    return config
+
+
+FINAL_VALIDATE_SCHEMA = _final_validate_ledc
+
+
+def _validate_output_mode(config):
+    if CONF_OUTPUT in config and config[CONF_OUTPUT_MODE] != "gpio":
+        raise cv.Invalid(f"{CONF_OUTPUT_MODE} only applies to {CONF_PIN}")
+    return config
+
+
+CONFIG_SCHEMA = cv.All(
+    cv.Schema(
+        {
+            cv.Required(CONF_ID): cv.declare_id(BuzzerComponent),
+            cv.Optional(CONF_PIN): pins.gpio_output_pin_schema,
+            # Any float output, e.g. channel 16 of a pico_uart_expander.
+            cv.Optional(CONF_OUTPUT): cv.use_id(output.FloatOutput),
+            cv.Optional(CONF_OUTPUT_MODE, default="gpio"): cv.enum(OUTPUT_MODES, lower=True),
+            # Default to the variant's last channel and timer 3.
+            cv.Optional(CONF_LEDC_TIMER): cv.int_range(min=0, max=LEDC_TIMERS - 1),
+            cv.Optional(CONF_LEDC_CHANNEL): cv.int_range(min=0, max=7),
+            # 10-bit duty resolution reaches roughly 80 Hz - 78 kHz.
+            cv.Optional(CONF_MIN_FREQUENCY, default="1000Hz"): cv.All(
+                cv.frequency, cv.float_range(min=100, max=20000)
+            ),
+            cv.Optional(CONF_MAX_FREQUENCY, default="4000Hz"): cv.All(
+                cv.frequency, cv.float_range(min=100, max=20000)
+            ),
+            cv.Optional(CONF_KEY_BEEP_TONE, default=255): cv.int_range(min=1, max=255),
+        }
+    ).extend(cv.COMPONENT_SCHEMA),
+    cv.has_exactly_one_key(CONF_PIN, CONF_OUTPUT),
+    _validate_output_mode,
+    _validate_ledc,
+    _validate_frequency_range,
+)
 
 async def to_code(config):
     var = cg.new_Pvariable(config[CONF_ID])
     await cg.register_component(var, config)
-    pin = await cg.gpio_pin_expression(config[CONF_PIN])
-    cg.add(var.set_pin(pin))
+    if CONF_OUTPUT in config:
+        out = await cg.get_variable(config[CONF_OUTPUT])
+        cg.add(var.set_float_output(out))
+        cg.add(var.set_output_mode(BuzzerOutputMode.FLOAT))
+    else:
+        pin = await cg.gpio_pin_expression(config[CONF_PIN])
+        cg.add(var.set_pin(pin))
+        cg.add(var.set_output_mode(config[CONF_OUTPUT_MODE]))
+    if config[CONF_OUTPUT_MODE] == "ledc":
+        cg.add(var.set_ledc(config[CONF_LEDC_TIMER], config[CONF_LEDC_CHANNEL]))
+        cg.add(var.set_frequency_range(int(config[CONF_MIN_FREQUENCY]), int(config[CONF_MAX_FREQUENCY])))
+    cg.add(var.set_key_beep_tone(config[CONF_KEY_BEEP_TONE]))
 
 @automation.register_action(
     "buzzer.start",
@@ -52,6 +204,14 @@ async def to_code(config):
             cv.Optional(CONF_BEEP_LENGTH, default="200ms"): cv.templatable(
                 cv.positive_time_period_milliseconds
             ),
+            # Per-beep pitch, cycled over the beeps (LEDC output mode).
+            cv.Optional(CONF_TONES): cv.All(
+                cv.ensure_list(cv.int_range(min=0, max=255)), cv.Length(min=1, max=8)
+            ),
+            cv.Optional(CONF_SOURCE, default="default"): cv.enum(SOURCES, lower=True),
+            # Overrides the source's built-in priority (alarm 100, entry
+            # delay 60, exit delay 50, fault 40, chime 20, default 10).
+            cv.Optional(CONF_PRIORITY): cv.int_range(min=0, max=255),
         }
     ),
 )
@@ -77,16 +237,35 @@ async def buzzer_start_to_code(config, action_id, template_arg, args):
     beep_length = await cg.templatable(config[CONF_BEEP_LENGTH], args, cg.uint32)
     cg.add(action.set_beep_length(beep_length))
 
+    if CONF_TONES in config:
+        cg.add(action.set_tones(config[CONF_TONES]))
+
+    cg.add(action.set_source(config[CONF_SOURCE]))
+    if CONF_PRIORITY in config:
+        cg.add(action.set_priority(config[CONF_PRIORITY]))
+
     return action
 
 @automation.register_action(
     "buzzer.stop",
     StopAction,
-    cv.Schema({cv.Required(CONF_ID): cv.use_id(BuzzerComponent)}),
+    cv.Schema(
+        {
+            cv.Required(CONF_ID): cv.use_id(BuzzerComponent),
+            cv.Optional(CONF_SOURCE, default="default"): cv.one_of(
+                *SOURCES, SOURCE_ALL, lower=True
+            ),
+        }
+    ),
 )
 async def buzzer_stop_to_code(config, action_id, template_arg, args):
     parent = await cg.get_variable(config[CONF_ID])
-    return cg.new_Pvariable(action_id, template_arg, parent)
+    action = cg.new_Pvariable(action_id, template_arg, parent)
+    if config[CONF_SOURCE] == SOURCE_ALL:
+        cg.add(action.set_all(True))
+    else:
+        cg.add(action.set_source(SOURCES[config[CONF_SOURCE]]))
+    return action
 
 @automation.register_action(
     "buzzer.key_beep",
@@ -1,151 +1,344 @@
 #include "buzzer.h"
 #include "switch/buzzer_mute_switch.h"   // Needed for full definition of BuzzerMuteSwitch
 #include "esphome/core/log.h"
-#include "esp_timer.h"
 
 namespace esphome {
 namespace buzzer {
 
 static const char *const TAG = "buzzer";
 
-static inline uint32_t now_ms() {
-  return (uint32_t)(esp_timer_get_time() / 1000ULL);
+const char *buzzer_source_name(BuzzerSource source) {
+  switch (source) {
+    case BuzzerSource::DEFAULT: return "default";
+    case BuzzerSource::ALARM: return "alarm";
+    case BuzzerSource::FAULT: return "fault";
+    case BuzzerSource::ENTRY_DELAY: return "entry_delay";
+    case BuzzerSource::EXIT_DELAY: return "exit_delay";
+    case BuzzerSource::CHIME: return "chime";
+    default: return "unknown";
+  }
+}
+
+// Alarm beats everything; an entry delay needs the user's attention more
+// than an exit delay, and both more than an ongoing fault.
+uint8_t buzzer_default_priority(BuzzerSource source) {
+  switch (source) {
+    case BuzzerSource::ALARM: return 100;
+    case BuzzerSource::ENTRY_DELAY: return 60;
+    case BuzzerSource::EXIT_DELAY: return 50;
+    case BuzzerSource::FAULT: return 40;
+    case BuzzerSource::CHIME: return 20;
+    default: return 10;
+  }
+}
+
+// beep, short pause, beep, ... beep [, long pause if repeating]; a
+// repeating pattern with 0 beeps still plays one.
+uint16_t BuzzerPattern::num_steps() const {
+  uint16_t n = this->beeps ? this->beeps : 1;
+  return (uint16_t) (2 * n - 1 + (this->repeat ? 1 : 0));
+}
+
+BuzzerStep BuzzerPattern::step(uint16_t index) const {
+  uint16_t n = this->beeps ? this->beeps : 1;
+  if (index >= 2 * n - 1)
+    return {0, this->long_pause};
+  if (index & 1)
+    return {0, this->short_pause};
+  uint8_t t = this->n_tones ? this->tones[(index / 2) % this->n_tones] : this->tone;
+  return {t, this->beep_length};
 }
 
 void BuzzerComponent::setup() {
-  if (this->pin_ != nullptr) {
-    this->pin_->setup();
-    this->pin_->digital_write(false);
+  switch (this->output_mode_) {
+    case BuzzerOutputMode::LEDC:
+      this->output_.reset(new LedcBuzzerOutput(this->pin_, this->ledc_timer_, this->ledc_channel_,
+                                               this->min_frequency_, this->max_frequency_));
+      break;
+    case BuzzerOutputMode::FLOAT:
+      this->output_.reset(new FloatBuzzerOutput(this->float_output_));
+      break;
+    default:
+      this->output_.reset(new GpioBuzzerOutput(this->pin_));
+      break;
+  }
+  if (!this->output_->setup()) {
+    this->output_.reset();
+    this->mark_failed();
+    return;
+  }
+  this->output_timer_safe_ = this->output_->timer_safe();
+  this->io_mutex_ = xSemaphoreCreateMutex();
+  if (this->io_mutex_ == nullptr) {
+    ESP_LOGE(TAG, "Could not create output mutex");
+    this->output_.reset();
+    this->mark_failed();
+    return;
+  }
+
+  esp_timer_create_args_t args{};
+  args.dispatch_method = ESP_TIMER_TASK;
+  args.arg = this;
+  args.callback = &BuzzerComponent::pattern_timer_cb_;
+  args.name = "buzzer_pattern";
+  esp_err_t err = esp_timer_create(&args, &this->pattern_timer_);
+  if (err == ESP_OK) {
+    args.callback = &BuzzerComponent::key_timer_cb_;
+    args.name = "buzzer_key";
+    err = esp_timer_create(&args, &this->key_timer_);
+  }
+  if (err != ESP_OK) {
+    ESP_LOGE(TAG, "esp_timer_create failed: %s", esp_err_to_name(err));
+    this->mark_failed();
+    return;
   }
   this->update_mute_switch_states();
 }
 
 void BuzzerComponent::loop() {
-  uint32_t now = now_ms();
-
-  // Key beep retrigger logic
-  if (KEY_BEEP_RETRIGGER_MODE) {
-    if (this->key_beep_gap_phase_ && now >= this->key_beep_next_start_) {
-      if (this->key_beep_pending_ > 0) {
-        this->key_beep_pending_--;
-        this->key_beep_gap_phase_ = false;
-        this->key_beep_active_ = true;
-        this->key_beep_end_ = now + KEY_BEEP_LEN_MS;
-        this->refresh_output_();
-        ESP_LOGV(TAG, "Key beep queued pulse start");
-      } else {
-        this->key_beep_gap_phase_ = false;
-        this->refresh_output_();
-      }
-    }
-    if (this->key_beep_active_ && now >= this->key_beep_end_) {
-      this->key_beep_active_ = false;
-      if (this->key_beep_pending_ > 0) {
-        this->key_beep_gap_phase_ = true;
-        this->key_beep_next_start_ = now + KEY_BEEP_GAP_MS;
+  // Timing lives in the timer callbacks; loop() only writes outputs that
+  // are not timer safe and reports a finished pattern.
+  this->apply_pending_();
+
+  uint32_t finished;
+  portENTER_CRITICAL(&this->lock_);
+  finished = this->finished_mask_;
+  this->finished_mask_ = 0;
+  portEXIT_CRITICAL(&this->lock_);
+  for (uint8_t i = 0; finished != 0; i++, finished >>= 1) {
+    if (finished & 1)
+      ESP_LOGD(TAG, "Pattern finished (%s)", buzzer_source_name((BuzzerSource) i));
+  }
+}
+
+void BuzzerComponent::dump_config() {
+  ESP_LOGCONFIG(TAG, "Buzzer:");
+  if (this->output_ != nullptr)
+    this->output_->dump_config();
+  ESP_LOGCONFIG(TAG, "  Key beep tone: %u", this->key_beep_tone_);
+}
+
+// A timer callback more than this ahead of its deadline is left over from
+// before the deadline moved; the re-arm that follows handles it.
+static constexpr uint64_t EARLY_FIRE_SLACK_US = 500;
+
+void BuzzerComponent::set_deadline_(uint64_t &due, bool &rearm, int64_t ms) {
+  due = ms < 0 ? 0 : (uint64_t) esp_timer_get_time() + (uint64_t) ms * 1000ULL;
+  rearm = true;
+}
+
+void BuzzerComponent::run_pattern_step_() {
+  Slot &slot = this->slots_[this->current_];
+  BuzzerStep step = slot.pattern.step(slot.pos);
+  if (step.duration_ms == 0) {
+    // Zero-length steps pass silently in 1 ms, which also stops an
+    // all-zero repeating pattern from spinning the timer task.
+    step = {0, 1};
+  }
+  this->pattern_tone_ = step.tone;
+  this->refresh_output_();
+  this->set_deadline_(this->pattern_due_us_, this->pattern_rearm_, step.duration_ms);
+}
+
+void BuzzerComponent::select_slot_(bool restart) {
+  int8_t best = -1;
+  for (uint8_t i = 0; i < (uint8_t) BuzzerSource::COUNT; i++) {
+    if (this->slots_[i].active && (best < 0 || this->slots_[i].priority > this->slots_[best].priority))
+      best = (int8_t) i;
+  }
+  if (best == this->current_ && !restart)
+    return;
+  this->current_ = best;
+  if (best < 0) {
+    this->set_deadline_(this->pattern_due_us_, this->pattern_rearm_, -1);
+    this->pattern_tone_ = 0;
+    this->refresh_output_();
+    return;
+  }
+  // A pre-empted slot kept its position; it resumes at the start of the
+  // step it was interrupted in.
+  this->run_pattern_step_();
+}
+
+void BuzzerComponent::pattern_timer_cb_(void *arg) {
+  auto *self = static_cast<BuzzerComponent *>(arg);
+  uint64_t now = esp_timer_get_time();
+  portENTER_CRITICAL(&self->lock_);
+  if (self->current_ >= 0 && self->pattern_due_us_ != 0 && now + EARLY_FIRE_SLACK_US >= self->pattern_due_us_) {
+    Slot &slot = self->slots_[self->current_];
+    if (++slot.pos >= slot.pattern.num_steps()) {
+      slot.pos = 0;
+      if (!slot.pattern.repeat) {
+        slot.active = false;
+        self->finished_mask_ |= 1u << self->current_;
       }
-      this->refresh_output_();
-      ESP_LOGV(TAG, "Key beep pulse ended");
     }
-  } else {
-    if (this->key_beep_active_ && now >= this->key_beep_end_) {
-      this->key_beep_active_ = false;
-      this->refresh_output_();
-      ESP_LOGV(TAG, "Key beep ended");
+    if (slot.active) {
+      self->run_pattern_step_();
+    } else {
+      self->select_slot_(true);
     }
   }
+  portEXIT_CRITICAL(&self->lock_);
+  self->apply_pending_(true);
+}
 
-  // Pattern timing
-  if (!running_) return;
-  if (now - last_tick_ < current_interval_) return;
-  last_tick_ = now;
-
-  if (beep_on_) {
-    apply_value_(0);
-    beep_on_ = false;
-    beeps_done_++;
-    if (beeps_done_ >= beeps_) {
-      if (repeat_) {
-        beeps_done_ = 0;
-        current_interval_ = long_pause_;
-      } else {
-        running_ = false;
-      }
+void BuzzerComponent::key_timer_cb_(void *arg) {
+  auto *self = static_cast<BuzzerComponent *>(arg);
+  uint64_t now = esp_timer_get_time();
+  portENTER_CRITICAL(&self->lock_);
+  if (self->key_due_us_ == 0 || now + EARLY_FIRE_SLACK_US < self->key_due_us_) {
+    // stale: the deadline moved and its re-arm is on the way
+  } else if (self->key_beep_gap_phase_) {
+    // Gap over: start the next queued pulse (the gap is only entered with one pending).
+    self->key_beep_gap_phase_ = false;
+    if (self->key_beep_pending_ > 0) {
+      self->key_beep_pending_--;
+      self->key_beep_active_ = true;
+      self->set_deadline_(self->key_due_us_, self->key_rearm_, KEY_BEEP_LEN_MS);
     } else {
-      current_interval_ = short_pause_;
+      self->set_deadline_(self->key_due_us_, self->key_rearm_, -1);
     }
-  } else {
-    apply_value_(tone_);
-    beep_on_ = true;
-    current_interval_ = beep_length_;
+    self->refresh_output_();
+  } else if (self->key_beep_active_) {
+    self->key_beep_active_ = false;
+    if (KEY_BEEP_RETRIGGER_MODE && self->key_beep_pending_ > 0) {
+      self->key_beep_gap_phase_ = true;
+      self->set_deadline_(self->key_due_us_, self->key_rearm_, KEY_BEEP_GAP_MS);
+    } else {
+      self->set_deadline_(self->key_due_us_, self->key_rearm_, -1);
+    }
+    self->refresh_output_();
   }
+  portEXIT_CRITICAL(&self->lock_);
+  self->apply_pending_(true);
 }
 
 void BuzzerComponent::start(uint8_t beeps, uint32_t short_pause, uint32_t long_pause,
-                            uint8_t tone, bool repeat, uint32_t beep_length) {
-  this->beeps_ = beeps;
-  this->short_pause_ = short_pause;
-  this->long_pause_ = long_pause;
-  this->tone_ = tone;
-  this->repeat_ = repeat;
-  this->beep_length_ = beep_length;
-  this->beeps_done_ = 0;
-  this->beep_on_ = false;
-  this->running_ = true;
-  this->last_tick_ = now_ms();
-  this->current_interval_ = 0;
-
-  if (beeps == 0 && !repeat) {
-    this->running_ = false;
-    apply_value_(0);
+                            uint8_t tone, bool repeat, uint32_t beep_length,
+                            const std::vector<uint8_t> &tones) {
+  BuzzerPattern p;
+  p.beeps = beeps;
+  p.short_pause = short_pause;
+  p.long_pause = long_pause;
+  p.tone = tone;
+  p.repeat = repeat;
+  p.beep_length = beep_length;
+  for (uint8_t t : tones) {
+    if (p.n_tones == BuzzerPattern::MAX_TONES)
+      break;
+    p.tones[p.n_tones++] = t;
+  }
+  this->play(BuzzerSource::DEFAULT, p);
+}
+
+void BuzzerComponent::stop() { this->stop(BuzzerSource::DEFAULT); }
+
+void BuzzerComponent::play(BuzzerSource source, const BuzzerPattern &pattern, int16_t priority) {
+  if (source >= BuzzerSource::COUNT)
+    return;
+  if (pattern.beeps == 0 && !pattern.repeat) {
+    this->stop(source);
     ESP_LOGD(TAG, "Start with 0 beeps & no repeat: nothing to play");
     return;
   }
 
-  ESP_LOGD(TAG, "Started pattern: beeps=%u short=%ums long=%ums tone=%u repeat=%d len=%ums",
-           beeps, short_pause, long_pause, tone, repeat, beep_length);
+  auto idx = (int8_t) source;
+  bool playing;
+  portENTER_CRITICAL(&this->lock_);
+  Slot &slot = this->slots_[idx];
+  slot.pattern = pattern;
+  slot.priority = priority < 0 ? buzzer_default_priority(source) : (uint8_t) priority;
+  slot.pos = 0;
+  slot.active = true;
+  this->finished_mask_ &= ~(1u << idx);
+  this->select_slot_(this->current_ == idx);
+  playing = this->current_ == idx;
+  portEXIT_CRITICAL(&this->lock_);
+  this->apply_pending_();
+
+  ESP_LOGD(TAG, "Started %s pattern (prio %u%s): beeps=%u short=%ums long=%ums tone=%u repeat=%d len=%ums",
+           buzzer_source_name(source), slot.priority, playing ? "" : ", waiting", pattern.beeps,
+           (unsigned) pattern.short_pause, (unsigned) pattern.long_pause, pattern.tone, pattern.repeat,
+           (unsigned) pattern.beep_length);
 }
 
-void BuzzerComponent::stop() {
-  this->running_ = false;
-  this->beep_on_ = false;
-  apply_value_(0);
-  ESP_LOGD(TAG, "Stopped pattern");
+void BuzzerComponent::stop(BuzzerSource source) {
+  if (source >= BuzzerSource::COUNT)
+    return;
+  auto idx = (int8_t) source;
+  portENTER_CRITICAL(&this->lock_);
+  this->slots_[idx].active = false;
+  this->slots_[idx].pos = 0;
+  if (this->current_ == idx)
+    this->select_slot_(true);
+  portEXIT_CRITICAL(&this->lock_);
+  this->apply_pending_();
+  ESP_LOGD(TAG, "Stopped %s pattern", buzzer_source_name(source));
+}
+
+void BuzzerComponent::stop_all() {
+  portENTER_CRITICAL(&this->lock_);
+  for (auto &slot : this->slots_) {
+    slot.active = false;
+    slot.pos = 0;
+  }
+  this->select_slot_(true);
+  portEXIT_CRITICAL(&this->lock_);
+  this->apply_pending_();
+  ESP_LOGD(TAG, "Stopped all patterns");
+}
+
+bool BuzzerComponent::is_active(BuzzerSource source) const {
+  return source < BuzzerSource::COUNT && this->slots_[(size_t) source].active;
 }
 
 void BuzzerComponent::key_beep() {
-  uint32_t now = now_ms();
-  if (KEY_BEEP_RETRIGGER_MODE) {
-    if (this->key_beep_active_ || this->key_beep_gap_phase_) {
-      if (this->key_beep_pending_ < 10)
-        this->key_beep_pending_++;
-      ESP_LOGV(TAG, "Key beep queued (pending=%u)", this->key_beep_pending_);
-      return;
-    }
-    this->key_beep_active_ = true;
-    this->key_beep_end_ = now + KEY_BEEP_LEN_MS;
-    this->refresh_output_();
-    ESP_LOGV(TAG, "Key beep start");
+  bool queued = false;
+  uint8_t pending;
+  portENTER_CRITICAL(&this->lock_);
+  if (KEY_BEEP_RETRIGGER_MODE && (this->key_beep_active_ || this->key_beep_gap_phase_)) {
+    if (this->key_beep_pending_ < 10)
+      this->key_beep_pending_++;
+    queued = true;
   } else {
+    // Simple mode re-arms the timer, stretching a pulse that is still running.
     this->key_beep_active_ = true;
-    this->key_beep_end_ = now + KEY_BEEP_LEN_MS;
+    this->set_deadline_(this->key_due_us_, this->key_rearm_, KEY_BEEP_LEN_MS);
     this->refresh_output_();
-    ESP_LOGV(TAG, "Key beep (simple) triggered");
+  }
+  pending = this->key_beep_pending_;
+  portEXIT_CRITICAL(&this->lock_);
+  this->apply_pending_();
+
+  if (queued) {
+    ESP_LOGV(TAG, "Key beep queued (pending=%u)", pending);
+  } else {
+    ESP_LOGV(TAG, "Key beep start");
   }
 }
 
+// Mute flags are only written from the main loop; the lock keeps the timer
+// task from reading a half-applied change through refresh_output_().
+#define BUZZER_SET_FLAG(flag, value) \
+  do { \
+    portENTER_CRITICAL(&this->lock_); \
+    this->flag = (value); \
+    this->refresh_output_(); \
+    portEXIT_CRITICAL(&this->lock_); \
+    this->apply_pending_(); \
+  } while (0)
+
 void BuzzerComponent::tone_mute() {
   if (!this->tone_muted_) {
-    this->tone_muted_ = true;
-    this->refresh_output_();
+    BUZZER_SET_FLAG(tone_muted_, true);
     this->update_mute_switch_states();
     ESP_LOGD(TAG, "Tone muted");
   }
 }
 void BuzzerComponent::tone_unmute() {
   if (this->tone_muted_) {
-    this->tone_muted_ = false;
-    this->refresh_output_();
+    BUZZER_SET_FLAG(tone_muted_, false);
     this->update_mute_switch_states();
     ESP_LOGD(TAG, "Tone unmuted");
   }
@@ -153,16 +346,14 @@ void BuzzerComponent::tone_unmute() {
 
 void BuzzerComponent::beep_mute() {
   if (!this->beep_muted_) {
-    this->beep_muted_ = true;
-    this->refresh_output_();
+    BUZZER_SET_FLAG(beep_muted_, true);
     this->update_mute_switch_states();
     ESP_LOGD(TAG, "Key beeps muted");
   }
 }
 void BuzzerComponent::beep_unmute() {
   if (this->beep_muted_) {
-    this->beep_muted_ = false;
-    this->refresh_output_();
+    BUZZER_SET_FLAG(beep_muted_, false);
     this->update_mute_switch_states();
     ESP_LOGD(TAG, "Key beeps unmuted");
   }
@@ -170,35 +361,70 @@ void BuzzerComponent::beep_unmute() {
 
 void BuzzerComponent::pinmode_mute() {
   if (!this->pinmode_muted_) {
-    this->pinmode_muted_ = true;
-    this->refresh_output_();
+    BUZZER_SET_FLAG(pinmode_muted_, true);
     ESP_LOGD(TAG, "Pinmode muted");
   }
 }
 void BuzzerComponent::pinmode_unmute() {
   if (this->pinmode_muted_) {
-    this->pinmode_muted_ = false;
-    this->refresh_output_();
+    BUZZER_SET_FLAG(pinmode_muted_, false);
     ESP_LOGD(TAG, "Pinmode unmuted");
   }
 }
 
-void BuzzerComponent::apply_value_(uint8_t value) {
-  this->pattern_output_high_ = (value != 0);
-  this->refresh_output_();
-  ESP_LOGV(TAG, "Pattern logical=%s", this->pattern_output_high_ ? "HIGH" : "LOW");
-}
+#undef BUZZER_SET_FLAG
 
 void BuzzerComponent::refresh_output_() {
-  if (this->pin_ != nullptr) {
-    bool pattern_active = this->pattern_output_high_ && !this->tone_muted_ && !this->pinmode_muted_;
-    bool key_layer_active = (this->key_beep_active_ && !this->beep_muted_);
-    bool final_level = pattern_active || key_layer_active;
-    if (this->key_beep_gap_phase_) {
-      final_level = pattern_active;  // gap suppresses key layer
-    }
-    this->pin_->digital_write(final_level);
+  if (this->output_ == nullptr)
+    return;
+  uint8_t pattern_tone = (!this->tone_muted_ && !this->pinmode_muted_) ? this->pattern_tone_ : 0;
+  bool key_layer_active = (this->key_beep_active_ && !this->beep_muted_);
+  // The key beep plays over the pattern at its own pitch; the gap between
+  // queued key beeps suppresses the key layer.
+  uint8_t final_tone = (key_layer_active && !this->key_beep_gap_phase_) ? this->key_beep_tone_ : pattern_tone;
+  this->output_tone_ = final_tone;
+  this->output_dirty_ = true;
+}
+
+void BuzzerComponent::apply_pending_(bool from_timer) {
+  if (this->output_ == nullptr || this->io_mutex_ == nullptr)
+    return;
+  // State is read inside the mutex, so whichever context applies last
+  // also read last and neither output nor timers go back to stale values.
+  // Non-timer-safe outputs stay dirty for loop().
+  bool write_output = !from_timer || this->output_timer_safe_;
+  xSemaphoreTake(this->io_mutex_, portMAX_DELAY);
+  bool dirty = false, pattern_rearm, key_rearm;
+  uint8_t tone;
+  uint64_t pattern_due, key_due;
+  portENTER_CRITICAL(&this->lock_);
+  if (write_output) {
+    dirty = this->output_dirty_;
+    this->output_dirty_ = false;
+  }
+  tone = this->output_tone_;
+  pattern_rearm = this->pattern_rearm_;
+  pattern_due = this->pattern_due_us_;
+  key_rearm = this->key_rearm_;
+  key_due = this->key_due_us_;
+  this->pattern_rearm_ = false;
+  this->key_rearm_ = false;
+  portEXIT_CRITICAL(&this->lock_);
+
+  uint64_t now = esp_timer_get_time();
+  if (pattern_rearm && this->pattern_timer_ != nullptr) {
+    esp_timer_stop(this->pattern_timer_);  // no-op if idle
+    if (pattern_due != 0)
+      esp_timer_start_once(this->pattern_timer_, pattern_due > now ? pattern_due - now : 0);
+  }
+  if (key_rearm && this->key_timer_ != nullptr) {
+    esp_timer_stop(this->key_timer_);
+    if (key_due != 0)
+      esp_timer_start_once(this->key_timer_, key_due > now ? key_due - now : 0);
   }
+  if (dirty)
+    this->output_->write(tone);
+  xSemaphoreGive(this->io_mutex_);
 }
 
 void BuzzerComponent::update_mute_switch_states() {
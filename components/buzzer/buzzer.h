@@ -3,6 +3,12 @@
 #include "esphome/core/component.h"
 #include "esphome/core/automation.h"
 #include "esphome/core/hal.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "esp_timer.h"
+#include "buzzer_output.h"
+#include <memory>
+#include <vector>
 
 namespace esphome {
 namespace buzzer {
@@ -10,17 +16,87 @@ namespace buzzer {
 // Forward declare switch helper
 class BuzzerMuteSwitch;
 
+// Selects the BuzzerOutput built in setup(): GPIO switches the pin (active
+// buzzer), LEDC plays the tone as a square wave (passive buzzer), FLOAT
+// hands it to a FloatOutput such as a pico_uart_expander channel.
+enum class BuzzerOutputMode : uint8_t { GPIO, LEDC, FLOAT };
+
+// Who asked for a pattern. Each source owns one slot; the highest-priority
+// active slot plays and the others wait, then resume where they were
+// interrupted. DEFAULT is what start()/stop() without a source use. Key
+// beeps are not a slot: they play over whatever pattern is running.
+enum class BuzzerSource : uint8_t { DEFAULT, ALARM, FAULT, ENTRY_DELAY, EXIT_DELAY, CHIME, COUNT };
+
+const char *buzzer_source_name(BuzzerSource source);
+uint8_t buzzer_default_priority(BuzzerSource source);
+
+// One step of a pattern timeline: play tone (0 = silent) for duration_ms,
+// then move to the next step.
+struct BuzzerStep {
+  uint8_t tone;
+  uint32_t duration_ms;
+};
+
+// A beep pattern: beeps separated by short_pause, then long_pause before
+// repeating. tones, if n_tones > 0, sets the pitch of each beep in turn.
+// Steps are derived on the fly by step(), so nothing is allocated.
+struct BuzzerPattern {
+  static constexpr uint8_t MAX_TONES = 8;
+  uint8_t beeps{1};
+  uint8_t tone{255};
+  bool repeat{false};
+  uint32_t short_pause{100};
+  uint32_t long_pause{500};
+  uint32_t beep_length{200};
+  uint8_t tones[MAX_TONES]{};
+  uint8_t n_tones{0};
+
+  uint16_t num_steps() const;
+  BuzzerStep step(uint16_t index) const;
+};
+
+// Timing runs on two one-shot esp_timers, one for the playing pattern and
+// one for key beeps, so edges land within about a millisecond however busy
+// the main loop is. State shared with the timer task is guarded by lock_.
+// Under it, state changes only record the new tone and timer deadlines;
+// apply_pending_() writes the output and re-arms the timers after the
+// lock is released, serialised by io_mutex_ so the newest state is always
+// the one applied last. Timer-safe
+// outputs (internal GPIO, LEDC) are written from the timer task; the rest
+// from loop() only, so a burst of edges costs one bus write per loop.
 class BuzzerComponent : public Component {
  public:
   void setup() override;
   void loop() override;
+  void dump_config() override;
 
   void set_pin(GPIOPin *pin) { this->pin_ = pin; }
+  void set_float_output(output::FloatOutput *output) { this->float_output_ = output; }
+  void set_output_mode(BuzzerOutputMode mode) { this->output_mode_ = mode; }
+  void set_ledc(uint8_t timer, uint8_t channel) {
+    this->ledc_timer_ = timer;
+    this->ledc_channel_ = channel;
+  }
+  void set_frequency_range(uint32_t min_hz, uint32_t max_hz) {
+    this->min_frequency_ = min_hz;
+    this->max_frequency_ = max_hz;
+  }
+  void set_key_beep_tone(uint8_t tone) { this->key_beep_tone_ = tone; }
 
+  // tones, if given, sets the pitch of each beep in turn (cycling) and
+  // overrides tone.
   void start(uint8_t beeps, uint32_t short_pause, uint32_t long_pause,
-             uint8_t tone, bool repeat, uint32_t beep_length = 200);
+             uint8_t tone, bool repeat, uint32_t beep_length = 200,
+             const std::vector<uint8_t> &tones = {});
   void stop();
 
+  // Queue pattern on source's slot, replacing what that source had.
+  // priority < 0 keeps buzzer_default_priority(source).
+  void play(BuzzerSource source, const BuzzerPattern &pattern, int16_t priority = -1);
+  void stop(BuzzerSource source);
+  void stop_all();
+  bool is_active(BuzzerSource source) const;
+
   void key_beep();
 
   // Mute controls
@@ -40,34 +116,66 @@ class BuzzerComponent : public Component {
   bool beep_muted() const { return beep_muted_; }
 
  protected:
-  void apply_value_(uint8_t value);
+  struct Slot {
+    BuzzerPattern pattern;
+    uint8_t priority{0};
+    bool active{false};
+    uint16_t pos{0};
+  };
+
+  // All of these expect lock_ to be held.
+  void run_pattern_step_();
+  // Make the highest-priority active slot current; restart re-runs its
+  // step even if it was already playing.
+  void select_slot_(bool restart);
   void refresh_output_();
+  // Record a deadline ms from now (ms < 0: stop) for apply_pending_().
+  void set_deadline_(uint64_t &due, bool &rearm, int64_t ms);
+
+  // Re-arms timers whose deadline changed and writes the tone computed by
+  // refresh_output_(); call without lock_ held. From the timer task only
+  // timer-safe outputs are written.
+  void apply_pending_(bool from_timer = false);
+
+  static void pattern_timer_cb_(void *arg);
+  static void key_timer_cb_(void *arg);
 
   GPIOPin *pin_{nullptr};
+  output::FloatOutput *float_output_{nullptr};
+  std::unique_ptr<BuzzerOutput> output_;
+  bool output_timer_safe_{false};
+  portMUX_TYPE lock_ = portMUX_INITIALIZER_UNLOCKED;
+  SemaphoreHandle_t io_mutex_{nullptr};
+  esp_timer_handle_t pattern_timer_{nullptr};
+  esp_timer_handle_t key_timer_{nullptr};
+  uint64_t pattern_due_us_{0};  // esp_timer time the current step ends, 0 = idle
+  uint64_t key_due_us_{0};
+  bool pattern_rearm_{false};
+  bool key_rearm_{false};
+  uint8_t output_tone_{0};  // last computed output, 0 = silent
+  bool output_dirty_{false};
+
+  // Output backend settings
+  BuzzerOutputMode output_mode_{BuzzerOutputMode::GPIO};
+  uint8_t ledc_timer_{3};
+  uint8_t ledc_channel_{5};  // codegen picks per variant; 5 exists on all
+  uint32_t min_frequency_{1000};
+  uint32_t max_frequency_{4000};
 
-  // Pattern state
-  bool running_{false};
-  bool beep_on_{false};
-  bool repeat_{false};
-  uint8_t beeps_{1};
-  uint8_t beeps_done_{0};
-  uint8_t tone_{255};
-  uint32_t short_pause_{100};
-  uint32_t long_pause_{500};
-  uint32_t beep_length_{200};
-  uint32_t current_interval_{0};
-  uint32_t last_tick_{0};
-  bool pattern_output_high_{false};
+  // Pattern scheduler: one preallocated slot per source
+  Slot slots_[(size_t) BuzzerSource::COUNT];
+  int8_t current_{-1};  // slot playing, -1 = none
+  uint8_t pattern_tone_{0};
+  uint32_t finished_mask_{0};  // sources that finished, reported from loop()
 
   // Key beep overlay + retrigger
   bool key_beep_active_{false};
-  uint32_t key_beep_end_{0};
+  uint8_t key_beep_tone_{255};
   static constexpr uint32_t KEY_BEEP_LEN_MS = 50;
   static constexpr bool KEY_BEEP_RETRIGGER_MODE = true;
   static constexpr uint32_t KEY_BEEP_GAP_MS = 8;
   uint8_t key_beep_pending_{0};
   bool key_beep_gap_phase_{false};
-  uint32_t key_beep_next_start_{0};
 
   // Mutes
   bool tone_muted_{false};
@@ -89,24 +197,47 @@ template<typename... Ts> class StartAction : public Action<Ts...> {
   TEMPLATABLE_VALUE(uint8_t, tone)
   TEMPLATABLE_VALUE(bool, repeat)
   TEMPLATABLE_VALUE(uint32_t, beep_length)
+  void set_tones(const std::vector<uint8_t> &tones) { this->tones_ = tones; }
+  void set_source(BuzzerSource source) { this->source_ = source; }
+  void set_priority(uint8_t priority) { this->priority_ = priority; }
   void play(Ts... x) override {
-    this->parent_->start(this->beeps_.value(x...),
-                         this->short_pause_.value(x...),
-                         this->long_pause_.value(x...),
-                         this->tone_.value(x...),
-                         this->repeat_.value(x...),
-                         this->beep_length_.value(x...));
+    BuzzerPattern p;
+    p.beeps = this->beeps_.value(x...);
+    p.short_pause = this->short_pause_.value(x...);
+    p.long_pause = this->long_pause_.value(x...);
+    p.tone = this->tone_.value(x...);
+    p.repeat = this->repeat_.value(x...);
+    p.beep_length = this->beep_length_.value(x...);
+    for (uint8_t t : this->tones_) {
+      if (p.n_tones == BuzzerPattern::MAX_TONES)
+        break;
+      p.tones[p.n_tones++] = t;
+    }
+    this->parent_->play(this->source_, p, this->priority_);
   }
  private:
   BuzzerComponent *parent_;
+  std::vector<uint8_t> tones_;
+  BuzzerSource source_{BuzzerSource::DEFAULT};
+  int16_t priority_{-1};
 };
 
 template<typename... Ts> class StopAction : public Action<Ts...> {
  public:
   explicit StopAction(BuzzerComponent *parent) : parent_(parent) {}
-  void play(Ts... x) override { this->parent_->stop(); }
+  void set_source(BuzzerSource source) { this->source_ = source; }
+  void set_all(bool all) { this->all_ = all; }
+  void play(Ts... x) override {
+    if (this->all_) {
+      this->parent_->stop_all();
+    } else {
+      this->parent_->stop(this->source_);
+    }
+  }
  private:
   BuzzerComponent *parent_;
+  BuzzerSource source_{BuzzerSource::DEFAULT};
+  bool all_{false};
 };
 
 template<typename... Ts> class KeyBeepAction : public Action<Ts...> {
@@ -0,0 +1,111 @@
+#include "buzzer_output.h"
+#include "esphome/core/log.h"
+
+namespace esphome {
+namespace buzzer {
+
+static const char *const TAG = "buzzer.output";
+
+// 10-bit duty keeps the 50 % square wave exact across the audible range.
+static constexpr ledc_timer_bit_t LEDC_RESOLUTION = LEDC_TIMER_10_BIT;
+static constexpr uint32_t LEDC_HALF_DUTY = 1u << (LEDC_RESOLUTION - 1);
+
+bool GpioBuzzerOutput::setup() {
+  this->pin_->setup();
+  this->pin_->digital_write(false);
+  this->internal_ = this->pin_->is_internal();
+  return true;
+}
+
+void GpioBuzzerOutput::write(uint8_t tone) {
+  bool on = tone != 0;
+  if (on == this->on_)
+    return;
+  this->pin_->digital_write(on);
+  this->on_ = on;
+}
+
+void GpioBuzzerOutput::dump_config() {
+  ESP_LOGCONFIG(TAG, "  Output: GPIO%s", this->internal_ ? "" : " (written from loop)");
+  LOG_PIN("  Pin: ", this->pin_);
+}
+
+bool LedcBuzzerOutput::setup() {
+  if (!this->pin_->is_internal()) {
+    ESP_LOGE(TAG, "LEDC output needs an internal GPIO pin");
+    return false;
+  }
+  auto *pin = static_cast<InternalGPIOPin *>(this->pin_);
+
+  this->frequency_ = this->tone_frequency_(255);
+  ledc_timer_config_t timer_cfg{};
+  timer_cfg.speed_mode = LEDC_LOW_SPEED_MODE;
+  timer_cfg.duty_resolution = LEDC_RESOLUTION;
+  timer_cfg.timer_num = (ledc_timer_t) this->timer_;
+  timer_cfg.freq_hz = this->frequency_;
+  timer_cfg.clk_cfg = LEDC_AUTO_CLK;
+  esp_err_t err = ledc_timer_config(&timer_cfg);
+  if (err != ESP_OK) {
+    ESP_LOGE(TAG, "ledc_timer_config failed: %s", esp_err_to_name(err));
+    return false;
+  }
+
+  ledc_channel_config_t ch_cfg{};
+  ch_cfg.gpio_num = pin->get_pin();
+  ch_cfg.speed_mode = LEDC_LOW_SPEED_MODE;
+  ch_cfg.channel = (ledc_channel_t) this->channel_;
+  ch_cfg.intr_type = LEDC_INTR_DISABLE;
+  ch_cfg.timer_sel = (ledc_timer_t) this->timer_;
+  ch_cfg.duty = 0;
+  ch_cfg.hpoint = 0;
+  ch_cfg.flags.output_invert = pin->is_inverted();
+  err = ledc_channel_config(&ch_cfg);
+  if (err != ESP_OK) {
+    ESP_LOGE(TAG, "ledc_channel_config failed: %s", esp_err_to_name(err));
+    return false;
+  }
+  return true;
+}
+
+uint32_t LedcBuzzerOutput::tone_frequency_(uint8_t tone) const {
+  if (tone <= 1 || this->max_frequency_ <= this->min_frequency_)
+    return this->min_frequency_;
+  return this->min_frequency_ + (this->max_frequency_ - this->min_frequency_) * (tone - 1) / 254;
+}
+
+void LedcBuzzerOutput::write(uint8_t tone) {
+  // The LEDC keeps the square wave going on its own; only pitch and on/off
+  // changes touch it.
+  auto ch = (ledc_channel_t) this->channel_;
+  if (tone != 0) {
+    uint32_t freq = this->tone_frequency_(tone);
+    if (freq != this->frequency_) {
+      ledc_set_freq(LEDC_LOW_SPEED_MODE, (ledc_timer_t) this->timer_, freq);
+      this->frequency_ = freq;
+    }
+  }
+  bool on = tone != 0;
+  if (on != this->on_) {
+    ledc_set_duty(LEDC_LOW_SPEED_MODE, ch, on ? LEDC_HALF_DUTY : 0);
+    ledc_update_duty(LEDC_LOW_SPEED_MODE, ch);
+    this->on_ = on;
+  }
+}
+
+void LedcBuzzerOutput::dump_config() {
+  ESP_LOGCONFIG(TAG, "  Output: LEDC timer %u, channel %u, %u-%u Hz", this->timer_, this->channel_,
+                (unsigned) this->min_frequency_, (unsigned) this->max_frequency_);
+  LOG_PIN("  Pin: ", this->pin_);
+}
+
+void FloatBuzzerOutput::write(uint8_t tone) {
+  if (tone == this->last_)
+    return;
+  this->output_->set_level(tone / 255.0f);
+  this->last_ = tone;
+}
+
+void FloatBuzzerOutput::dump_config() { ESP_LOGCONFIG(TAG, "  Output: float output (written from loop)"); }
+
+}  // namespace buzzer
+}  // namespace esphome
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "esphome/core/hal.h"
+#include "esphome/components/output/float_output.h"
+#include "driver/ledc.h"
+
+namespace esphome {
+namespace buzzer {
+
+// Where the mixed buzzer signal goes. write() receives the current tone
+// (0 = silent) whenever it may have changed. Backends that are
+// timer_safe() are written straight from the esp_timer task; the rest are
+// written from the main loop, once per loop at most.
+class BuzzerOutput {
+ public:
+  virtual ~BuzzerOutput() = default;
+  virtual bool setup() { return true; }
+  virtual void write(uint8_t tone) = 0;
+  virtual bool timer_safe() const = 0;
+  virtual void dump_config() = 0;
+};
+
+// On/off on a GPIO pin, for active buzzers. Internal pins are plain
+// register writes; expander pins go over a bus and stay on the main loop.
+class GpioBuzzerOutput : public BuzzerOutput {
+ public:
+  explicit GpioBuzzerOutput(GPIOPin *pin) : pin_(pin) {}
+  bool setup() override;
+  void write(uint8_t tone) override;
+  bool timer_safe() const override { return this->internal_; }
+  void dump_config() override;
+
+ protected:
+  GPIOPin *pin_;
+  bool internal_{false};
+  bool on_{false};
+};
+
+// 50 % square wave from an LEDC channel, for passive buzzers. The tone
+// sets the pitch, linear from min_hz (tone 1) to max_hz (tone 255).
+class LedcBuzzerOutput : public BuzzerOutput {
+ public:
+  LedcBuzzerOutput(GPIOPin *pin, uint8_t timer, uint8_t channel, uint32_t min_hz, uint32_t max_hz)
+      : pin_(pin), timer_(timer), channel_(channel), min_frequency_(min_hz), max_frequency_(max_hz) {}
+  bool setup() override;
+  void write(uint8_t tone) override;
+  bool timer_safe() const override { return true; }
+  void dump_config() override;
+
+ protected:
+  uint32_t tone_frequency_(uint8_t tone) const;
+
+  GPIOPin *pin_;
+  uint8_t timer_;
+  uint8_t channel_;
+  uint32_t min_frequency_;
+  uint32_t max_frequency_;
+  uint32_t frequency_{0};
+  bool on_{false};
+};
+
+// Any FloatOutput, tone 0-255 mapped to 0.0-1.0; e.g. the buzzer channel
+// of a pico_uart_expander, which folds the change into its next frame.
+class FloatBuzzerOutput : public BuzzerOutput {
+ public:
+  explicit FloatBuzzerOutput(output::FloatOutput *output) : output_(output) {}
+  void write(uint8_t tone) override;
+  bool timer_safe() const override { return false; }
+  void dump_config() override;
+
+ protected:
+  output::FloatOutput *output_;
+  int16_t last_{-1};
+};
+
+}  // namespace buzzer
+}  // namespace esphome
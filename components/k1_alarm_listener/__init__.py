@@ -9,21 +9,39 @@ CONF_ALARM_ENTITY = "alarm_entity"
 CONF_ALARM_TYPE = "alarm_type"
 CONF_INCORRECT_PIN_TIMEOUT = "incorrect_pin_timeout"
 CONF_FAILED_OPEN_SENSORS_TIMEOUT = "failed_open_sensors_timeout"
+CONF_SETTLE_WINDOW = "settle_window"
+CONF_MAX_PUBLISH_LATENCY = "max_publish_latency"
 
 ALARM_TYPES = {
     "alarmo": 0,
     "other": 1,
 }
 
-CONFIG_SCHEMA = cv.Schema(
-    {
-        cv.GenerateID(): cv.declare_id(K1AlarmListener),
-        cv.Required(CONF_ALARM_ENTITY): cv.string,
-        cv.Optional(CONF_ALARM_TYPE, default="alarmo"): cv.one_of(*ALARM_TYPES.keys(), lower=True),
-        cv.Optional(CONF_INCORRECT_PIN_TIMEOUT, default="2s"): cv.positive_time_period_milliseconds,
-        cv.Optional(CONF_FAILED_OPEN_SENSORS_TIMEOUT, default="2s"): cv.positive_time_period_milliseconds,
-    }
-).extend(cv.COMPONENT_SCHEMA)
+
+def _validate_latency(config):
+    if config[CONF_MAX_PUBLISH_LATENCY] < config[CONF_SETTLE_WINDOW]:
+        raise cv.Invalid(f"{CONF_MAX_PUBLISH_LATENCY} must be at least {CONF_SETTLE_WINDOW}")
+    return config
+
+
+CONFIG_SCHEMA = cv.All(
+    cv.Schema(
+        {
+            cv.GenerateID(): cv.declare_id(K1AlarmListener),
+            cv.Required(CONF_ALARM_ENTITY): cv.string,
+            cv.Optional(CONF_ALARM_TYPE, default="alarmo"): cv.one_of(*ALARM_TYPES.keys(), lower=True),
+            cv.Optional(CONF_INCORRECT_PIN_TIMEOUT, default="2s"): cv.positive_time_period_milliseconds,
+            cv.Optional(CONF_FAILED_OPEN_SENSORS_TIMEOUT, default="2s"): cv.positive_time_period_milliseconds,
+            # State and attributes arrive as separate messages; wait this long
+            # for the rest of a transition before publishing (0 = next loop).
+            cv.Optional(CONF_SETTLE_WINDOW, default="50ms"): cv.All(
+                cv.positive_time_period_milliseconds, cv.Range(max=cv.TimePeriod(seconds=1))
+            ),
+            cv.Optional(CONF_MAX_PUBLISH_LATENCY, default="250ms"): cv.positive_time_period_milliseconds,
+        }
+    ).extend(cv.COMPONENT_SCHEMA),
+    _validate_latency,
+)
 
 
 async def to_code(config):
@@ -33,3 +51,5 @@ async def to_code(config):
     cg.add(var.set_alarm_type(ALARM_TYPES[config[CONF_ALARM_TYPE]]))
     cg.add(var.set_incorrect_pin_timeout_ms(config[CONF_INCORRECT_PIN_TIMEOUT]))
     cg.add(var.set_failed_open_sensors_timeout_ms(config[CONF_FAILED_OPEN_SENSORS_TIMEOUT]))
+    cg.add(var.set_settle_window_ms(config[CONF_SETTLE_WINDOW]))
+    cg.add(var.set_max_publish_latency_ms(config[CONF_MAX_PUBLISH_LATENCY]))
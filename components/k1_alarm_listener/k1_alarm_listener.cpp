@@ -1,6 +1,8 @@
 #include "k1_alarm_listener.h"
 #include "esphome/core/log.h"
 #include "esp_timer.h"
+#include <cctype>
+#include <cstring>
 
 namespace esphome {
 namespace k1_alarm_listener {
@@ -12,6 +14,124 @@ uint32_t K1AlarmListener::now_ms_() {
   return (uint32_t)(esp_timer_get_time() / 1000ULL);
 }
 
+// ---------- Parsing (runs once per HA message, no allocation) ----------
+// Case-insensitive match of s against a lowercase literal, ignoring
+// surrounding whitespace.
+static bool token_eq(const std::string &s, const char *lit) {
+  size_t b = 0, e = s.size();
+  while (b < e && isspace((unsigned char) s[b])) b++;
+  while (e > b && isspace((unsigned char) s[e - 1])) e--;
+  size_t n = strlen(lit);
+  if (e - b != n) return false;
+  for (size_t i = 0; i < n; i++) {
+    if ((char) std::tolower((unsigned char) s[b + i]) != lit[i]) return false;
+  }
+  return true;
+}
+
+static bool token_blank(const std::string &s) {
+  for (char c : s) {
+    if (!isspace((unsigned char) c)) return false;
+  }
+  return true;
+}
+
+static const struct {
+  const char *name;
+  HaAlarmState state;
+} HA_STATE_NAMES[] = {
+    {"disarmed", HaAlarmState::DISARMED},
+    {"disarming", HaAlarmState::DISARMING},
+    {"arming", HaAlarmState::ARMING},
+    {"pending", HaAlarmState::PENDING},
+    {"triggered", HaAlarmState::TRIGGERED},
+    {"armed_home", HaAlarmState::ARMED_HOME},
+    {"armed_away", HaAlarmState::ARMED_AWAY},
+    {"armed_night", HaAlarmState::ARMED_NIGHT},
+    {"armed_vacation", HaAlarmState::ARMED_VACATION},
+    {"armed_custom_bypass", HaAlarmState::ARMED_CUSTOM_BYPASS},
+    {"unavailable", HaAlarmState::UNAVAILABLE},
+    {"unknown", HaAlarmState::UNAVAILABLE},
+};
+
+static HaAlarmState parse_ha_state(const std::string &s) {
+  if (token_blank(s)) return HaAlarmState::NONE;
+  for (const auto &e : HA_STATE_NAMES) {
+    if (token_eq(s, e.name)) return e.state;
+  }
+  return HaAlarmState::OTHER;
+}
+
+// arm_mode and next_state both carry armed_* state names.
+static ArmMode parse_arm_mode(const std::string &s) {
+  static const char *const NAMES[] = {nullptr, "armed_home", "armed_away", "armed_night", "armed_vacation",
+                                      "armed_custom_bypass"};
+  for (uint8_t i = 1; i < (uint8_t) ArmMode::COUNT; i++) {
+    if (token_eq(s, NAMES[i])) return (ArmMode) i;
+  }
+  return ArmMode::NONE;
+}
+
+static bool attr_has_value(const std::string &v) {
+  return !token_blank(v) && !token_eq(v, "null") && !token_eq(v, "none");
+}
+
+static bool is_truthy_list(const std::string &v) {
+  return attr_has_value(v) && !token_eq(v, "[]") && !token_eq(v, "{}");
+}
+
+// ---------- Display state tables ----------
+const char *alarm_display_state_name(AlarmDisplayState s) {
+  static const char *const NAMES[] = {
+      "connection_timeout", "disarmed", "disarming", "triggered",
+      "arming", "arming_home", "arming_away", "arming_night", "arming_vacation", "arming_custom_bypass",
+      "pending", "pending_home", "pending_away", "pending_night", "pending_vacation", "pending_custom_bypass",
+      "armed_home", "armed_home_bypass", "armed_away", "armed_away_bypass", "armed_night", "armed_night_bypass",
+      "armed_vacation", "armed_vacation_bypass", "armed_custom_bypass",
+      "incorrect_pin", "failed_open_sensors", "other",
+  };
+  static_assert(sizeof(NAMES) / sizeof(NAMES[0]) == (size_t) AlarmDisplayState::OTHER + 1, "name per state");
+  return NAMES[(uint8_t) s];
+}
+
+// HA state shown as-is (alarm_type other, or no refinement applies).
+static const AlarmDisplayState BASE_DISPLAY[] = {
+    AlarmDisplayState::CONNECTION_TIMEOUT,   // NONE
+    AlarmDisplayState::CONNECTION_TIMEOUT,   // UNAVAILABLE
+    AlarmDisplayState::DISARMED,
+    AlarmDisplayState::DISARMING,
+    AlarmDisplayState::ARMING,
+    AlarmDisplayState::PENDING,
+    AlarmDisplayState::TRIGGERED,
+    AlarmDisplayState::ARMED_HOME,
+    AlarmDisplayState::ARMED_AWAY,
+    AlarmDisplayState::ARMED_NIGHT,
+    AlarmDisplayState::ARMED_VACATION,
+    AlarmDisplayState::ARMED_CUSTOM_BYPASS,
+    AlarmDisplayState::OTHER,
+};
+static_assert(sizeof(BASE_DISPLAY) / sizeof(BASE_DISPLAY[0]) == (size_t) HaAlarmState::OTHER + 1,
+              "display state per HA state");
+
+// Alarmo refinements, indexed by ArmMode.
+static const AlarmDisplayState ARMING_BY_MODE[] = {
+    AlarmDisplayState::ARMING, AlarmDisplayState::ARMING_HOME, AlarmDisplayState::ARMING_AWAY,
+    AlarmDisplayState::ARMING_NIGHT, AlarmDisplayState::ARMING_VACATION, AlarmDisplayState::ARMING_CUSTOM_BYPASS,
+};
+static const AlarmDisplayState PENDING_BY_MODE[] = {
+    AlarmDisplayState::PENDING, AlarmDisplayState::PENDING_HOME, AlarmDisplayState::PENDING_AWAY,
+    AlarmDisplayState::PENDING_NIGHT, AlarmDisplayState::PENDING_VACATION, AlarmDisplayState::PENDING_CUSTOM_BYPASS,
+};
+// [mode][bypassed]; custom bypass is always that mode, never a non-bypass variant.
+static const AlarmDisplayState ARMED_BY_MODE[][2] = {
+    {AlarmDisplayState::CONNECTION_TIMEOUT, AlarmDisplayState::CONNECTION_TIMEOUT},  // unused
+    {AlarmDisplayState::ARMED_HOME, AlarmDisplayState::ARMED_HOME_BYPASS},
+    {AlarmDisplayState::ARMED_AWAY, AlarmDisplayState::ARMED_AWAY_BYPASS},
+    {AlarmDisplayState::ARMED_NIGHT, AlarmDisplayState::ARMED_NIGHT_BYPASS},
+    {AlarmDisplayState::ARMED_VACATION, AlarmDisplayState::ARMED_VACATION_BYPASS},
+    {AlarmDisplayState::ARMED_CUSTOM_BYPASS, AlarmDisplayState::ARMED_CUSTOM_BYPASS},
+};
+
 // ---------- Setup ----------
 void K1AlarmListener::setup() {
   if (!initial_placeholder_done_) {
@@ -38,7 +158,6 @@ void K1AlarmListener::setup() {
   update_connection_sensor_(last_api_connected_);
 
   // Force initial recompute
-  mapped_state_.clear();
   schedule_state_publish();
 
   ESP_LOGI(TAG, "Subscribed to '%s' and attributes", alarm_entity_.c_str());
@@ -55,6 +174,7 @@ void K1AlarmListener::loop() {
   }
 
   tick_override_expiry_();
+  if (publish_pending_ && (int32_t)(now_ms_() - publish_due_ms_) >= 0) finalize_publish_();
 }
 
 // ---------- Dump Config ----------
@@ -64,11 +184,16 @@ void K1AlarmListener::dump_config() {
   ESP_LOGCONFIG(TAG, "  Alarm Type: %u", (unsigned) alarm_type_);
   ESP_LOGCONFIG(TAG, "  Incorrect PIN Timeout: %u ms", (unsigned) incorrect_pin_timeout_ms_);
   ESP_LOGCONFIG(TAG, "  Failed Open Sensors Timeout: %u ms", (unsigned) failed_open_sensors_timeout_ms_);
+  ESP_LOGCONFIG(TAG, "  Settle Window: %u ms (max latency %u ms)", (unsigned) settle_window_ms_,
+                (unsigned) max_publish_latency_ms_);
+  ESP_LOGCONFIG(TAG, "  Publishes: %u, suppressed intermediate states: %u", (unsigned) state_publishes_,
+                (unsigned) suppressed_publishes_);
   ESP_LOGCONFIG(TAG, "  API Connected (last): %s", last_api_connected_ ? "YES" : "NO");
   ESP_LOGCONFIG(TAG, "  Last Published: %s", last_published_state_.c_str());
   ESP_LOGCONFIG(TAG, "  Override Active: %s", override_active_ ? "YES" : "NO");
   if (override_active_) {
-    ESP_LOGCONFIG(TAG, "    Override State: %s (ends at %u ms)", override_state_.c_str(), override_end_ms_);
+    ESP_LOGCONFIG(TAG, "    Override State: %s (ends at %u ms)", alarm_display_state_name(override_state_),
+                  override_end_ms_);
   }
   ESP_LOGCONFIG(TAG, "  Attrs seen: arm_mode=%s next_state=%s bypassed=%s",
     attr_arm_mode_seen_ ? "YES":"NO",
@@ -78,32 +203,60 @@ void K1AlarmListener::dump_config() {
 
 // ---------- Scheduling ----------
 void K1AlarmListener::schedule_state_publish() {
-  publish_pending_ = true;
-  if (publish_scheduled_) return;
-  publish_scheduled_ = true;
-  this->set_timeout(0, [this]() {
-    this->publish_scheduled_ = false;
-    this->finalize_publish_();
-  });
+  uint32_t now = now_ms_();
+  if (!publish_pending_) {
+    publish_pending_ = true;
+    first_pending_ms_ = now;
+    batch_state_ = last_published_;
+    batch_changes_ = 0;
+  }
+  // Each change here is a publish an unbatched listener would have made.
+  AlarmDisplayState state = compute_effective_state_();
+  if (state != batch_state_) {
+    batch_state_ = state;
+    batch_changes_++;
+  }
+
+  // Each update restarts the settle window, capped by the latency bound
+  // counted from the first update of the batch.
+  uint32_t waited = now - first_pending_ms_;
+  uint32_t delay = settle_window_ms_;
+  if (waited >= max_publish_latency_ms_) {
+    delay = 0;
+  } else if (max_publish_latency_ms_ - waited < delay) {
+    delay = max_publish_latency_ms_ - waited;
+  }
+  publish_due_ms_ = now + delay;
 }
 
 void K1AlarmListener::finalize_publish_() {
   if (!publish_pending_) return;
   publish_pending_ = false;
-  std::string eff = compute_effective_state_();
-  publish_state_(eff);
+  uint32_t before = state_publishes_;
+  publish_display_state_(compute_effective_state_());
+  uint32_t published = state_publishes_ - before;
+  if (batch_changes_ > published) suppressed_publishes_ += batch_changes_ - published;
 }
 
 // ---------- Publishing Helpers ----------
 void K1AlarmListener::publish_initial_placeholder_() {
-  publish_state_("connection_timeout");
+  publish_display_state_(AlarmDisplayState::CONNECTION_TIMEOUT);
 }
 
-void K1AlarmListener::publish_state_(const std::string &state) {
-  if (state == last_published_state_) return;
+void K1AlarmListener::publish_display_state_(AlarmDisplayState state) {
+  // OTHER carries its own text, so only it needs the string comparison.
+  if (state == last_published_ && state != AlarmDisplayState::OTHER && !last_published_state_.empty()) return;
+  last_published_ = state;
+  publish_state_(state == AlarmDisplayState::OTHER ? other_state_.c_str() : alarm_display_state_name(state));
+}
+
+void K1AlarmListener::publish_state_(const char *state) {
+  if (last_published_state_ == state) return;
   last_published_state_ = state;
-  ESP_LOGD(TAG, "Publishing state: %s", state.c_str());
-  if (text_sensor_) text_sensor_->publish_state(state);
+  state_publishes_++;
+  ESP_LOGD(TAG, "Publishing state: %s (%u publishes, %u intermediate states suppressed)", state,
+           (unsigned) state_publishes_, (unsigned) suppressed_publishes_);
+  if (text_sensor_) text_sensor_->publish_state(last_published_state_);
 }
 
 void K1AlarmListener::update_connection_sensor_(bool connected) {
@@ -121,7 +274,7 @@ bool K1AlarmListener::api_connected_now_() const {
 }
 
 // ---------- Override Handling ----------
-void K1AlarmListener::start_override_(const std::string &state, uint32_t dur_ms) {
+void K1AlarmListener::start_override_(AlarmDisplayState state, uint32_t dur_ms) {
   override_active_ = true;
   override_state_ = state;
   override_end_ms_ = now_ms_() + dur_ms;
@@ -131,7 +284,6 @@ void K1AlarmListener::start_override_(const std::string &state, uint32_t dur_ms)
 void K1AlarmListener::clear_override_() {
   if (!override_active_) return;
   override_active_ = false;
-  override_state_.clear();
   override_end_ms_ = 0;
   schedule_state_publish();
 }
@@ -140,136 +292,70 @@ void K1AlarmListener::tick_override_expiry_() {
   if (!override_active_) return;
   uint32_t now = now_ms_();
   if (now >= override_end_ms_) {
-    ESP_LOGD(TAG, "Override expired (%s)", override_state_.c_str());
+    ESP_LOGD(TAG, "Override expired (%s)", alarm_display_state_name(override_state_));
     clear_override_();
   }
 }
 
-// ---------- Attribute helpers ----------
-bool K1AlarmListener::attr_has_value_(const std::string &v) const {
-  if (v.empty()) return false;
-  std::string low;
-  low.reserve(v.size());
-  for (char c: v) low.push_back((char) std::tolower((unsigned char)c));
-  return !(low == "null" || low == "none");
-}
-
-bool K1AlarmListener::is_truthy_list_(const std::string &v) const {
-  if (v.empty()) return false;
-  std::string trimmed = v;
-  while (!trimmed.empty() && isspace((unsigned char)trimmed.front())) trimmed.erase(trimmed.begin());
-  while (!trimmed.empty() && isspace((unsigned char)trimmed.back())) trimmed.pop_back();
-  std::string low;
-  low.reserve(trimmed.size());
-  for (char c: trimmed) low.push_back((char) std::tolower((unsigned char)c));
-  if (low == "null" || low == "none" || low == "[]" || low == "{}")
-    return false;
-  return true;
-}
-
-// ---------- Mapping & Transitional ----------
-std::string K1AlarmListener::map_raw_state_(const std::string &raw) const {
-  std::string low;
-  low.reserve(raw.size());
-  for (char c: raw) low.push_back((char) std::tolower((unsigned char)c));
-  if (low == "unavailable" || low == "unknown")
-    return "connection_timeout";
-  return low;
-}
-
-bool K1AlarmListener::is_transitional_generic_(const std::string &s) const {
-  return s == "arming" || s == "pending";
-}
-
-bool K1AlarmListener::transitional_has_required_attrs_(const std::string &mapped) const {
-  if (mapped == "arming") return attr_arm_mode_seen_;
-  if (mapped == "pending") return attr_arm_mode_seen_ || attr_next_state_seen_;
+// ---------- Transitional ----------
+bool K1AlarmListener::transitional_has_required_attrs_() const {
+  if (base_state_ == HaAlarmState::ARMING) return attr_arm_mode_seen_;
+  if (base_state_ == HaAlarmState::PENDING) return attr_arm_mode_seen_ || attr_next_state_seen_;
   return true;
 }
 
 // ---------- Effective State Computation ----------
-std::string K1AlarmListener::compute_effective_state_() {
+AlarmDisplayState K1AlarmListener::compute_effective_state_() const {
   if (!api_connected_now_())
-    return "connection_timeout";
-
-  mapped_state_ = map_raw_state_(raw_state_);
-
-  if (mapped_state_.empty())
-    return "connection_timeout";
+    return AlarmDisplayState::CONNECTION_TIMEOUT;
 
-  if (mapped_state_ == "connection_timeout")
-    return "connection_timeout";
+  if (base_state_ == HaAlarmState::NONE || base_state_ == HaAlarmState::UNAVAILABLE)
+    return AlarmDisplayState::CONNECTION_TIMEOUT;
 
   if (override_active_) {
     return override_state_;
   }
 
-  if (is_transitional_generic_(mapped_state_)) {
-    if (!transitional_has_required_attrs_(mapped_state_)) {
-      return "connection_timeout";
-    }
+  if (!transitional_has_required_attrs_()) {
+    return AlarmDisplayState::CONNECTION_TIMEOUT;
   }
 
-  std::string inferred = (alarm_type_ == AlarmIntegrationType::ALARMO)
-                           ? infer_alarm_state_(mapped_state_)
-                           : mapped_state_;
-
-  return inferred;
+  return (alarm_type_ == AlarmIntegrationType::ALARMO) ? infer_alarm_state_() : BASE_DISPLAY[(uint8_t) base_state_];
 }
 
-std::string K1AlarmListener::infer_alarm_state_(const std::string &mapped) {
-  auto lower_trim = [](std::string s) {
-    while (!s.empty() && isspace((unsigned char)s.front())) s.erase(s.begin());
-    while (!s.empty() && isspace((unsigned char)s.back())) s.pop_back();
-    std::string out; out.reserve(s.size());
-    for (char c: s) out.push_back((char) std::tolower((unsigned char)c));
-    return out;
-  };
-
-  std::string arm_mode = lower_trim(attr_arm_mode_);
-  std::string next_state = lower_trim(attr_next_state_);
-  bool bypassed_non_empty = is_truthy_list_(attr_bypassed_);
-
-  // Transitional disambiguation
-  if (mapped == "arming") {
-    if (arm_mode == "armed_home") return "arming_home";
-    if (arm_mode == "armed_away") return "arming_away";
-    if (arm_mode == "armed_night") return "arming_night";
-    if (arm_mode == "armed_vacation") return "arming_vacation";
-    if (arm_mode == "armed_custom_bypass") return "arming_custom_bypass";
-    return mapped;
-  }
-
-  if (mapped == "pending") {
-    if (arm_mode == "armed_home"        || next_state == "armed_home") return "pending_home";
-    if (arm_mode == "armed_away"        || next_state == "armed_away") return "pending_away";
-    if (arm_mode == "armed_night"       || next_state == "armed_night") return "pending_night";
-    if (arm_mode == "armed_vacation"    || next_state == "armed_vacation") return "pending_vacation";
-    if (arm_mode == "armed_custom_bypass" || next_state == "armed_custom_bypass") return "pending_custom_bypass";
-    return mapped;
+AlarmDisplayState K1AlarmListener::infer_alarm_state_() const {
+  switch (base_state_) {
+    // Transitional disambiguation
+    case HaAlarmState::ARMING:
+      return ARMING_BY_MODE[(uint8_t) arm_mode_];
+    case HaAlarmState::PENDING: {
+      // Either attribute may name the mode; if both do, home < away < night
+      // < vacation < custom_bypass decides.
+      ArmMode mode = arm_mode_;
+      if (mode == ArmMode::NONE || (next_state_ != ArmMode::NONE && next_state_ < mode)) mode = next_state_;
+      return PENDING_BY_MODE[(uint8_t) mode];
+    }
+    // Armed states with conditional bypass variants
+    case HaAlarmState::ARMED_HOME:
+    case HaAlarmState::ARMED_AWAY:
+    case HaAlarmState::ARMED_NIGHT:
+    case HaAlarmState::ARMED_VACATION:
+    case HaAlarmState::ARMED_CUSTOM_BYPASS: {
+      // ARMED_* run in ArmMode order starting at HOME.
+      uint8_t mode = (uint8_t) base_state_ - (uint8_t) HaAlarmState::ARMED_HOME + (uint8_t) ArmMode::HOME;
+      return ARMED_BY_MODE[mode][bypassed_ ? 1 : 0];
+    }
+    default:
+      return BASE_DISPLAY[(uint8_t) base_state_];
   }
-
-  // Armed states with conditional bypass variants (EXCEPT custom_bypass which is intrinsic)
-  if (mapped == "armed_home")     return bypassed_non_empty ? "armed_home_bypass" : "armed_home";
-  if (mapped == "armed_away")     return bypassed_non_empty ? "armed_away_bypass" : "armed_away";
-  if (mapped == "armed_night")    return bypassed_non_empty ? "armed_night_bypass" : "armed_night";
-  if (mapped == "armed_vacation") return bypassed_non_empty ? "armed_vacation_bypass" : "armed_vacation";
-
-  // Custom bypass is always that mode; never collapse to a non-bypass variant
-  if (mapped == "armed_custom_bypass") return "armed_custom_bypass";
-
-  return mapped;
 }
 
 // ---------- Failed Arm (Override) ----------
 void K1AlarmListener::handle_failed_arm_reason_(const std::string &reason) {
-  std::string low;
-  low.reserve(reason.size());
-  for (char c: reason) low.push_back((char) std::tolower((unsigned char)c));
-  if (low == "invalid_code" || low == "not_allowed") {
-    start_override_("incorrect_pin", incorrect_pin_timeout_ms_);
-  } else if (low == "open_sensors") {
-    start_override_("failed_open_sensors", failed_open_sensors_timeout_ms_);
+  if (token_eq(reason, "invalid_code") || token_eq(reason, "not_allowed")) {
+    start_override_(AlarmDisplayState::INCORRECT_PIN, incorrect_pin_timeout_ms_);
+  } else if (token_eq(reason, "open_sensors")) {
+    start_override_(AlarmDisplayState::FAILED_OPEN_SENSORS, failed_open_sensors_timeout_ms_);
   } else {
     ESP_LOGD(TAG, "Unknown failed_arm reason: %s", reason.c_str());
   }
@@ -277,45 +363,44 @@ void K1AlarmListener::handle_failed_arm_reason_(const std::string &reason) {
 
 // ---------- HA Callbacks ----------
 void K1AlarmListener::ha_state_callback_(std::string s) {
-  raw_state_ = std::move(s);
+  base_state_ = parse_ha_state(s);
+  if (base_state_ == HaAlarmState::OTHER) {
+    // Unmodelled state: keep its text for display, lowercased as before.
+    other_state_ = std::move(s);
+    for (char &c : other_state_) c = (char) std::tolower((unsigned char) c);
+  }
   schedule_state_publish();
 }
 
 void K1AlarmListener::arm_mode_attr_callback_(std::string v) {
-  attr_arm_mode_ = std::move(v);
+  arm_mode_ = parse_arm_mode(v);
   bool prev = attr_arm_mode_seen_;
-  attr_arm_mode_seen_ = attr_has_value_(attr_arm_mode_);
+  attr_arm_mode_seen_ = attr_has_value(v);
   if (attr_arm_mode_seen_ && !prev) attributes_supported_ = true;
   schedule_state_publish();
 }
 
 void K1AlarmListener::next_state_attr_callback_(std::string v) {
-  attr_next_state_ = std::move(v);
+  next_state_ = parse_arm_mode(v);
   bool prev = attr_next_state_seen_;
-  attr_next_state_seen_ = attr_has_value_(attr_next_state_);
+  attr_next_state_seen_ = attr_has_value(v);
   if (attr_next_state_seen_ && !prev) attributes_supported_ = true;
   schedule_state_publish();
 }
 
 void K1AlarmListener::bypassed_attr_callback_(std::string v) {
-  attr_bypassed_ = std::move(v);
+  bypassed_ = is_truthy_list(v);
   bool prev = attr_bypassed_seen_;
-  attr_bypassed_seen_ = attr_has_value_(attr_bypassed_);
+  attr_bypassed_seen_ = attr_has_value(v);
   if (attr_bypassed_seen_ && !prev) attributes_supported_ = true;
   schedule_state_publish();
 }
 
 void K1AlarmListener::failed_arm_service_(std::string reason) {
   if (!api_connected_now_()) return;
-  if (mapped_state_ == "connection_timeout" || mapped_state_.empty()) return;
+  if (base_state_ == HaAlarmState::NONE || base_state_ == HaAlarmState::UNAVAILABLE) return;
   handle_failed_arm_reason_(reason);
 }
 
-// ------------- Internal callback method pointer wrappers -------------
-void K1AlarmListener::ha_state_callback_(std::string s);
-void K1AlarmListener::arm_mode_attr_callback_(std::string v);
-void K1AlarmListener::next_state_attr_callback_(std::string v);
-void K1AlarmListener::bypassed_attr_callback_(std::string v);
-
 }  // namespace k1_alarm_listener
 }  // namespace esphome
@@ -24,6 +24,62 @@ enum class K1AlarmListenerBinarySensorType : uint8_t {
   HA_CONNECTED = 0
 };
 
+// HA alarm_control_panel state, parsed once when it arrives. NONE = never
+// received, UNAVAILABLE covers unavailable/unknown, OTHER is any state we
+// don't model (kept as text and passed through).
+enum class HaAlarmState : uint8_t {
+  NONE,
+  UNAVAILABLE,
+  DISARMED,
+  DISARMING,
+  ARMING,
+  PENDING,
+  TRIGGERED,
+  ARMED_HOME,
+  ARMED_AWAY,
+  ARMED_NIGHT,
+  ARMED_VACATION,
+  ARMED_CUSTOM_BYPASS,
+  OTHER,
+};
+
+// arm_mode / next_state attribute value; NONE for anything else.
+enum class ArmMode : uint8_t { NONE, HOME, AWAY, NIGHT, VACATION, CUSTOM_BYPASS, COUNT };
+
+// What the text sensor shows. Only turned into a string when published.
+enum class AlarmDisplayState : uint8_t {
+  CONNECTION_TIMEOUT,
+  DISARMED,
+  DISARMING,
+  TRIGGERED,
+  ARMING,
+  ARMING_HOME,
+  ARMING_AWAY,
+  ARMING_NIGHT,
+  ARMING_VACATION,
+  ARMING_CUSTOM_BYPASS,
+  PENDING,
+  PENDING_HOME,
+  PENDING_AWAY,
+  PENDING_NIGHT,
+  PENDING_VACATION,
+  PENDING_CUSTOM_BYPASS,
+  ARMED_HOME,
+  ARMED_HOME_BYPASS,
+  ARMED_AWAY,
+  ARMED_AWAY_BYPASS,
+  ARMED_NIGHT,
+  ARMED_NIGHT_BYPASS,
+  ARMED_VACATION,
+  ARMED_VACATION_BYPASS,
+  ARMED_CUSTOM_BYPASS,
+  INCORRECT_PIN,
+  FAILED_OPEN_SENSORS,
+  OTHER,  // unmodelled HA state, shown as received (lowercased)
+};
+
+const char *alarm_display_state_name(AlarmDisplayState s);
+
 class K1AlarmListenerTextSensor;
 class K1AlarmListenerBinarySensor;
 
@@ -34,9 +90,11 @@ class K1AlarmListener : public Component, public api::CustomAPIDevice {
   void set_alarm_type(uint8_t t) { alarm_type_ = static_cast<AlarmIntegrationType>(t); }
   void set_incorrect_pin_timeout_ms(uint32_t v) { incorrect_pin_timeout_ms_ = v; }
   void set_failed_open_sensors_timeout_ms(uint32_t v) { failed_open_sensors_timeout_ms_ = v; }
+  void set_settle_window_ms(uint32_t v) { settle_window_ms_ = v; }
+  void set_max_publish_latency_ms(uint32_t v) { max_publish_latency_ms_ = v; }
 
   // Sensors
-  void set_text_sensor(K1AlarmListenerTextSensor *ts) { text_sensor_ = ts; if (!last_published_state_.empty()) publish_state_(last_published_state_); }
+  void set_text_sensor(K1AlarmListenerTextSensor *ts) { text_sensor_ = ts; if (!last_published_state_.empty()) publish_state_(last_published_state_.c_str()); }
   void register_ha_connection_sensor(binary_sensor::BinarySensor *bs) {
     ha_connection_sensor_ = bs;
     update_connection_sensor_(api_connected_now_());
@@ -48,9 +106,17 @@ class K1AlarmListener : public Component, public api::CustomAPIDevice {
   void dump_config() override;
   float get_setup_priority() const override { return setup_priority::DATA; }
 
-  // Called by internal code to schedule deferred publishing
+  // Called by internal code to schedule deferred publishing. HA sends the
+  // state and each attribute as separate messages, so updates are held
+  // until none has arrived for settle_window_ms_ (but no longer than
+  // max_publish_latency_ms_ after the first) and published once from
+  // loop(). Only a deadline is stored, so no scheduler item is allocated.
   void schedule_state_publish();
 
+  uint32_t state_publishes() const { return state_publishes_; }
+  // Intermediate states that publishing every update would have shown.
+  uint32_t suppressed_publishes() const { return suppressed_publishes_; }
+
   // Exposed so internal lambdas can use Component’s timeout
   void set_timeout(uint32_t ms, std::function<void()> &&f) { Component::set_timeout(ms, std::move(f)); }
 
@@ -60,6 +126,8 @@ class K1AlarmListener : public Component, public api::CustomAPIDevice {
   AlarmIntegrationType alarm_type_{AlarmIntegrationType::ALARMO};
   uint32_t incorrect_pin_timeout_ms_{2000};
   uint32_t failed_open_sensors_timeout_ms_{2000};
+  uint32_t settle_window_ms_{50};
+  uint32_t max_publish_latency_ms_{250};
 
   // ----- Sensors -----
   K1AlarmListenerTextSensor *text_sensor_{nullptr};
@@ -68,12 +136,12 @@ class K1AlarmListener : public Component, public api::CustomAPIDevice {
   // ----- Connection state -----
   bool last_api_connected_{true};
 
-  // ----- Raw & attribute state -----
-  std::string raw_state_;              // raw HA state
-  std::string mapped_state_;           // mapped base (unavailable->connection_timeout)
-  std::string attr_arm_mode_;
-  std::string attr_next_state_;
-  std::string attr_bypassed_;
+  // ----- Parsed HA state & attributes -----
+  HaAlarmState base_state_{HaAlarmState::NONE};
+  std::string other_state_;            // lowercased text when base_state_ is OTHER
+  ArmMode arm_mode_{ArmMode::NONE};
+  ArmMode next_state_{ArmMode::NONE};
+  bool bypassed_{false};               // bypassed_sensors is a non-empty list
 
   bool attr_arm_mode_seen_{false};
   bool attr_next_state_seen_{false};
@@ -82,13 +150,19 @@ class K1AlarmListener : public Component, public api::CustomAPIDevice {
 
   // ----- Override handling -----
   bool override_active_{false};
-  std::string override_state_;
+  AlarmDisplayState override_state_{AlarmDisplayState::INCORRECT_PIN};
   uint32_t override_end_ms_{0};
 
   // ----- Publish management -----
-  bool publish_scheduled_{false};
   bool publish_pending_{false};
-  std::string last_published_state_;
+  uint32_t first_pending_ms_{0};      // when the pending batch started
+  uint32_t publish_due_ms_{0};        // when loop() publishes the pending batch
+  AlarmDisplayState batch_state_{AlarmDisplayState::CONNECTION_TIMEOUT};  // latest state seen in the batch
+  uint16_t batch_changes_{0};         // state changes seen while the batch was pending
+  uint32_t state_publishes_{0};       // text sensor publishes
+  uint32_t suppressed_publishes_{0};  // intermediate states never published
+  AlarmDisplayState last_published_{AlarmDisplayState::CONNECTION_TIMEOUT};
+  std::string last_published_state_;  // text of last_published_, for late text sensors
   bool initial_placeholder_done_{false};
 
   // Timing helpers
@@ -97,18 +171,15 @@ class K1AlarmListener : public Component, public api::CustomAPIDevice {
   // Internal helpers
   bool api_connected_now_() const;
   void update_connection_sensor_(bool connected);
-  void publish_state_(const std::string &state);
+  void publish_state_(const char *state);
+  void publish_display_state_(AlarmDisplayState state);
   void publish_initial_placeholder_();
   void finalize_publish_();
-  std::string compute_effective_state_();
-  std::string infer_alarm_state_(const std::string &mapped);
-  std::string map_raw_state_(const std::string &raw) const;
-  bool is_transitional_generic_(const std::string &s) const;
-  bool transitional_has_required_attrs_(const std::string &mapped) const;
-  bool attr_has_value_(const std::string &v) const;
-  bool is_truthy_list_(const std::string &v) const;
-
-  void start_override_(const std::string &state, uint32_t dur_ms);
+  AlarmDisplayState compute_effective_state_() const;
+  AlarmDisplayState infer_alarm_state_() const;
+  bool transitional_has_required_attrs_() const;
+
+  void start_override_(AlarmDisplayState state, uint32_t dur_ms);
   void clear_override_();
   void handle_failed_arm_reason_(const std::string &reason);
   void tick_override_expiry_();
@@ -162,6 +162,8 @@ void K1UartComponent::parse_frames_() {
       if (buzzer_) buzzer_->key_beep();
       uint8_t code = frame[1];
       if (code != 0xFF && code != 0x51) {
+        // Local LED feedback; the strip shows it on its next loop.
+        if (arm_strip_) arm_strip_->key_feedback(!map_digit_(code).empty());
         uint64_t now_us = esp_timer_get_time();
         update_pinmode_timeout_(now_us);
       } else {
@@ -180,6 +182,7 @@ void K1UartComponent::parse_frames_() {
 // ---------- A0 (command / PIN entry) ----------
 void K1UartComponent::handle_a0_(const uint8_t *frame, size_t len) {
   if (len != LEN_A0 || frame[0] != ID_A0) return;
+  if (arm_strip_) arm_strip_->key_feedback_reset();  // PIN entry finished
 
   // Prefix digits (positions 1..3)
   std::string prefix;
@@ -346,6 +349,7 @@ void K1UartComponent::check_pinmode_expiry_(uint64_t now_us) {
   if (elapsed_us >= limit_us) {
     pinmode_active_ = false;
     if (buzzer_) buzzer_->pinmode_unmute();
+    if (arm_strip_) arm_strip_->key_feedback_reset();
     ESP_LOGV(TAG, "Pinmode exited (timeout %ums)", pinmode_timeout_ms_);
   }
 }
@@ -11,6 +11,9 @@ void PicoUartExpanderComponent::setup() {
   ESP_LOGCONFIG(TAG, "Setting up PicoUartExpander UART device...");
   // Initialize all data bytes to 0
   memset(data_bytes_, 0, sizeof(data_bytes_));
+  // The Pico may have kept channels from before our reboot; the first
+  // frame goes out regardless so it matches data_bytes_ again.
+  dirty_ = true;
   
   // Get the UART port number from the parent component
   auto *idf_uart = static_cast<uart::IDFUARTComponent*>(this->parent_);
@@ -19,6 +22,12 @@ void PicoUartExpanderComponent::setup() {
   ESP_LOGD(TAG, "Using UART port %d", uart_num_);
 }
 
+void PicoUartExpanderComponent::loop() {
+  if (!dirty_) return;
+  dirty_ = false;
+  send_uart_message();
+}
+
 void PicoUartExpanderComponent::dump_config() {
   ESP_LOGCONFIG(TAG, "PicoUartExpander (UART LED driver)");
   ESP_LOGCONFIG(TAG, "  UART Port: %d", uart_num_);
@@ -37,13 +46,13 @@ void PicoUartExpanderComponent::write_value(uint8_t channel, uint8_t value) {
   // Convert channel number to array index (channel 1-16 -> index 0-15)
   uint8_t index = channel - 1;
   
-  // Update the data array
+  if (data_bytes_[index] == value) return;
+
+  // Update the data array; the frame goes out from loop()
   data_bytes_[index] = value;
+  dirty_ = true;
   
   ESP_LOGV(TAG, "Channel %d updated to 0x%02X", channel, value);
-  
-  // Send complete message immediately
-  send_uart_message();
 }
 
 void PicoUartExpanderComponent::send_uart_message() {
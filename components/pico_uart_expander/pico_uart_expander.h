@@ -9,10 +9,14 @@
 namespace esphome {
 namespace pico_uart_expander {
 
-/** Hub: UART device managing 15 LED channels + 1 buzzer channel */
+/** Hub: UART device managing 15 LED channels + 1 buzzer channel.
+ *  Writes only update the channel array; loop() sends one frame for all
+ *  changes made since the last one, so a buzzer pattern edge and an LED
+ *  change in the same loop share a frame. */
 class PicoUartExpanderComponent : public Component, public uart::UARTDevice {
  public:
   void setup() override;
+  void loop() override;
   void dump_config() override;
   float get_setup_priority() const override { return setup_priority::IO; }
 
@@ -22,6 +26,7 @@ class PicoUartExpanderComponent : public Component, public uart::UARTDevice {
   void send_uart_message();
   
   uint8_t data_bytes_[16] = {0};  // 15 LED channels + 1 buzzer channel
+  bool dirty_{false};             // data_bytes_ changed since the last frame
   uart_port_t uart_num_;          // ESP32 UART port number
 };
 